@@ -0,0 +1,399 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "AdaptorOCL/ProgramCache.hpp"
+
+#include "common/LLVMWarningsPush.hpp"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "common/LLVMWarningsPop.hpp"
+
+#include "common/igc_regkeys.hpp"
+#include "common/secure_mem.h"
+#include "Probe/Assertion.h"
+#include "version.h"
+
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <type_traits>
+
+using namespace llvm;
+
+namespace TC
+{
+    ProgramCache::Stats ProgramCache::s_stats;
+
+    namespace
+    {
+        // Cache file layout: header followed by output, debug data and
+        // message (warnings) payloads.
+        struct EntryHeader
+        {
+            char     magic[8];
+            uint32_t outputSize;
+            uint32_t debugDataSize;
+            uint32_t messageSize;
+            uint32_t flags;
+        };
+        const char ENTRY_MAGIC[8] = { 'I', 'G', 'C', 'P', 'C', 'A', 'C', '1' };
+
+        // EntryHeader::flags
+        const uint32_t ENTRY_FLAG_TIER0 = 0x1;
+
+        // Entry names must carry this prefix, llvm::pruneCache ignores other files.
+        const char ENTRY_PREFIX[] = "llvmcache-";
+
+        // Only scalars are hashed through their bytes; structs are hashed field
+        // by field so that padding and unused bitfield bits do not change keys.
+        template <typename T>
+        void hashPOD(MD5& hash, const T& value)
+        {
+            static_assert(std::is_scalar<T>::value, "hash struct fields explicitly");
+            hash.update(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(&value), sizeof(T)));
+        }
+
+        void hashBuffer(MD5& hash, const void* data, size_t size)
+        {
+            hashPOD(hash, static_cast<uint64_t>(size));
+            if (data && size)
+            {
+                hash.update(ArrayRef<uint8_t>(static_cast<const uint8_t*>(data), size));
+            }
+        }
+
+        char* copyToNewBuffer(StringRef data)
+        {
+            if (data.empty())
+            {
+                return nullptr;
+            }
+            char* buffer = new char[data.size()];
+            memcpy_s(buffer, data.size(), data.data(), data.size());
+            return buffer;
+        }
+
+        void hashPlatform(MD5& hash, const IGC::CPlatform& platform)
+        {
+            const PLATFORM& info = platform.getPlatformInfo();
+            hashPOD(hash, info.eProductFamily);
+            hashPOD(hash, info.ePCHProductFamily);
+            hashPOD(hash, info.eDisplayCoreFamily);
+            hashPOD(hash, info.eRenderCoreFamily);
+#ifndef _COMMON_PPA
+            hashPOD(hash, info.ePlatformType);
+#endif
+            hashPOD(hash, info.usDeviceID);
+            hashPOD(hash, info.usRevId);
+            hashPOD(hash, info.usDeviceID_PCH);
+            hashPOD(hash, info.usRevId_PCH);
+            hashPOD(hash, info.eGTType);
+
+            const WA_TABLE& waTable = platform.getWATable();
+#define WA_DECLARE(wa, wa_comment, wa_bugType, wa_impact, wa_component) \
+            hashPOD(hash, static_cast<uint8_t>(waTable.wa));
+#include "inc/common/sku_wa_defs.h"
+#undef WA_DECLARE
+
+            // The SKU features read by the compiler.
+            const SKU_FEATURE_TABLE& skuTable = platform.getSkuTable();
+            hashPOD(hash, static_cast<uint8_t>(skuTable.FtrLocalMemory));
+            hashPOD(hash, static_cast<uint8_t>(skuTable.FtrPooledEuEnabled));
+            hashPOD(hash, static_cast<uint8_t>(skuTable.FtrWddm2Svm));
+
+            // Media box and per-slice details do not affect compilation.
+            const GT_SYSTEM_INFO sysInfo = platform.GetGTSystemInfo();
+            hashPOD(hash, sysInfo.EUCount);
+            hashPOD(hash, sysInfo.ThreadCount);
+            hashPOD(hash, sysInfo.SliceCount);
+            hashPOD(hash, sysInfo.SubSliceCount);
+            hashPOD(hash, sysInfo.DualSubSliceCount);
+            hashPOD(hash, sysInfo.L3CacheSizeInKb);
+            hashPOD(hash, sysInfo.LLCCacheSizeInKb);
+            hashPOD(hash, sysInfo.EdramSizeInKb);
+            hashPOD(hash, sysInfo.L3BankCount);
+            hashPOD(hash, sysInfo.MaxFillRate);
+            hashPOD(hash, sysInfo.EuCountPerPoolMax);
+            hashPOD(hash, sysInfo.EuCountPerPoolMin);
+            hashPOD(hash, sysInfo.TotalVsThreads);
+            hashPOD(hash, sysInfo.TotalHsThreads);
+            hashPOD(hash, sysInfo.TotalDsThreads);
+            hashPOD(hash, sysInfo.TotalGsThreads);
+            hashPOD(hash, sysInfo.TotalPsThreadsWindowerRange);
+            hashPOD(hash, sysInfo.TotalVsThreads_Pocs);
+            hashPOD(hash, sysInfo.CsrSizeInMb);
+            hashPOD(hash, sysInfo.MaxEuPerSubSlice);
+            hashPOD(hash, sysInfo.MaxSlicesSupported);
+            hashPOD(hash, sysInfo.MaxSubSlicesSupported);
+            hashPOD(hash, sysInfo.MaxDualSubSlicesSupported);
+            hashPOD(hash, sysInfo.IsL3HashModeEnabled);
+            hashPOD(hash, sysInfo.IsDynamicallyPopulated);
+            hashPOD(hash, sysInfo.ReservedCCSWays);
+            hashPOD(hash, sysInfo.MultiTileArchInfo.TileCount);
+            hashPOD(hash, sysInfo.MultiTileArchInfo.TileMask);
+            hashPOD(hash, sysInfo.MultiTileArchInfo.IsValid);
+            hashPOD(hash, sysInfo.SLMSizeInKb);
+        }
+
+        // Bytes of entries in dir.
+        uint64_t measureCache(const std::string& dir)
+        {
+            uint64_t bytes = 0;
+            std::error_code ec;
+            for (sys::fs::directory_iterator it(dir, ec), end; it != end && !ec; it.increment(ec))
+            {
+                if (!sys::path::filename(it->path()).startswith(ENTRY_PREFIX))
+                {
+                    continue;
+                }
+                ErrorOr<sys::fs::basic_file_status> status = it->status();
+                if (status)
+                {
+                    bytes += status->getSize();
+                }
+            }
+            return bytes;
+        }
+
+        // Approximate size of the cache directory. It is measured when the
+        // first entry of the process is stored and then grown by the entries
+        // this process stores, so the directory is only walked again once
+        // the limit is crossed.
+        struct CacheSize
+        {
+            std::mutex mutex;
+            std::string dir;
+            uint64_t bytes = 0;
+        };
+
+        CacheSize& getCacheSize()
+        {
+            static CacheSize cacheSize;
+            return cacheSize;
+        }
+
+        const char* getIGCBuildId()
+        {
+#ifdef IGC_REVISION
+            return IGC_REVISION;
+#else
+            // Without a revision, never reuse entries across rebuilds.
+            return __DATE__ " " __TIME__;
+#endif
+        }
+    }
+
+    ProgramCache::ProgramCache(
+        const STB_TranslateInputArgs* pInputArgs,
+        TB_DATA_FORMAT inputDataFormat,
+        const IGC::CPlatform& platform)
+    {
+        const char* cacheDir = IGC_GET_REGKEYSTRING(ProgramCacheDir);
+        if (cacheDir == nullptr || cacheDir[0] == '\0')
+        {
+            return;
+        }
+
+        // Instrumented and debug builds must always go through the compiler.
+        if (pInputArgs->GTPinInput ||
+            pInputArgs->TracingOptionsCount ||
+            pInputArgs->NumVISAAsmsToLink ||
+            pInputArgs->CompileTimeStatisticsEnable ||
+            IGC_IS_FLAG_ENABLED(ShaderDumpEnable) ||
+            IGC_IS_FLAG_ENABLED(ShaderOverride))
+        {
+            return;
+        }
+
+        if (sys::fs::create_directories(cacheDir))
+        {
+            return;
+        }
+
+        MD5 hash;
+        hashPOD(hash, inputDataFormat);
+        hashBuffer(hash, pInputArgs->pInput, pInputArgs->InputSize);
+        hashBuffer(hash, pInputArgs->pOptions, pInputArgs->OptionsSize);
+        hashBuffer(hash, pInputArgs->pInternalOptions, pInputArgs->InternalOptionsSize);
+        hashBuffer(hash, pInputArgs->pSpecConstantsIds,
+            pInputArgs->SpecConstantsSize * sizeof(*pInputArgs->pSpecConstantsIds));
+        hashBuffer(hash, pInputArgs->pSpecConstantsValues,
+            pInputArgs->SpecConstantsSize * sizeof(*pInputArgs->pSpecConstantsValues));
+
+        hashPlatform(hash, platform);
+
+        std::string keyValues, optionKeys;
+        GetKeysSetExplicitly(&keyValues, &optionKeys);
+        hashBuffer(hash, keyValues.data(), keyValues.size());
+
+        const char* buildId = getIGCBuildId();
+        hashBuffer(hash, buildId, strlen(buildId));
+
+        MD5::MD5Result result;
+        hash.final(result);
+
+        SmallString<256> entryPath(cacheDir);
+        sys::path::append(entryPath, std::string(ENTRY_PREFIX) + result.digest().str().str());
+        m_cacheDir = cacheDir;
+        m_entryPath = entryPath.str().str();
+    }
+
+    bool ProgramCache::load(STB_TranslateOutputArgs* pOutputArgs)
+    {
+        IGC_ASSERT(isEnabled());
+
+        // Opening with OF_UpdateAtime keeps LRU eviction informed of the hit.
+        int fd = -1;
+        if (sys::fs::openFileForRead(m_entryPath, fd, sys::fs::OF_UpdateAtime))
+        {
+            s_stats.misses++;
+            printStats("miss");
+            return false;
+        }
+        auto bufferOrErr = MemoryBuffer::getOpenFile(
+            sys::fs::convertFDToNativeFile(fd), m_entryPath, -1, false);
+        sys::fs::closeFile(fd);
+
+        bool valid = false;
+        if (bufferOrErr)
+        {
+            StringRef data = (*bufferOrErr)->getBuffer();
+            EntryHeader header;
+            if (data.size() >= sizeof(header))
+            {
+                memcpy_s(&header, sizeof(header), data.data(), sizeof(header));
+                uint64_t payloadSize = (uint64_t)header.outputSize + header.debugDataSize + header.messageSize;
+                valid = memcmp(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) == 0 &&
+                    header.outputSize != 0 &&
+                    sizeof(header) + payloadSize == data.size();
+            }
+
+            if (valid)
+            {
+                StringRef payload = data.drop_front(sizeof(header));
+                pOutputArgs->pOutput = copyToNewBuffer(payload.take_front(header.outputSize));
+                pOutputArgs->OutputSize = header.outputSize;
+                payload = payload.drop_front(header.outputSize);
+                pOutputArgs->pDebugData = copyToNewBuffer(payload.take_front(header.debugDataSize));
+                pOutputArgs->DebugDataSize = header.debugDataSize;
+                payload = payload.drop_front(header.debugDataSize);
+                pOutputArgs->pErrorString = copyToNewBuffer(payload);
+                pOutputArgs->ErrorStringSize = header.messageSize;
+                pOutputArgs->Tier0Binary = (header.flags & ENTRY_FLAG_TIER0) != 0;
+                s_stats.bytesLoaded += data.size();
+            }
+        }
+
+        if (!valid)
+        {
+            // Truncated or foreign file; drop it so it is rebuilt.
+            sys::fs::remove(m_entryPath);
+            s_stats.misses++;
+            printStats("miss");
+            return false;
+        }
+
+        s_stats.hits++;
+        printStats("hit");
+        return true;
+    }
+
+    void ProgramCache::store(const STB_TranslateOutputArgs* pOutputArgs)
+    {
+        IGC_ASSERT(isEnabled());
+        if (pOutputArgs->pOutput == nullptr || pOutputArgs->OutputSize == 0)
+        {
+            return;
+        }
+
+        EntryHeader header = {};
+        memcpy_s(header.magic, sizeof(header.magic), ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+        header.outputSize = pOutputArgs->OutputSize;
+        header.debugDataSize = pOutputArgs->pDebugData ? pOutputArgs->DebugDataSize : 0;
+        header.messageSize = pOutputArgs->pErrorString ? pOutputArgs->ErrorStringSize : 0;
+        header.flags = pOutputArgs->Tier0Binary ? ENTRY_FLAG_TIER0 : 0;
+
+        // Write to a private temporary file and rename it into place so that
+        // readers in other threads or processes only ever see complete entries.
+        SmallString<256> tempModel(m_cacheDir);
+        sys::path::append(tempModel, "tmp-%%%%%%%%%%%%");
+        int fd = -1;
+        SmallString<256> tempPath;
+        if (sys::fs::createUniqueFile(tempModel, fd, tempPath))
+        {
+            return;
+        }
+
+        bool ok;
+        {
+            raw_fd_ostream os(fd, /*shouldClose*/ true);
+            os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            os.write(pOutputArgs->pOutput, header.outputSize);
+            if (header.debugDataSize)
+            {
+                os.write(pOutputArgs->pDebugData, header.debugDataSize);
+            }
+            if (header.messageSize)
+            {
+                os.write(pOutputArgs->pErrorString, header.messageSize);
+            }
+            os.close();
+            ok = !os.has_error();
+            os.clear_error();
+        }
+
+        if (!ok || sys::fs::rename(tempPath, m_entryPath))
+        {
+            sys::fs::remove(tempPath);
+            return;
+        }
+
+        s_stats.stores++;
+        s_stats.bytesStored += sizeof(header) + (uint64_t)header.outputSize +
+            header.debugDataSize + header.messageSize;
+        printStats("store");
+
+        const uint64_t maxSizeBytes = (uint64_t)IGC_GET_FLAG_VALUE(ProgramCacheMaxSizeMB) * 1024 * 1024;
+        CacheSize& cacheSize = getCacheSize();
+        std::lock_guard<std::mutex> lock(cacheSize.mutex);
+        const bool firstStore = cacheSize.dir != m_cacheDir;
+        cacheSize.bytes += sizeof(header) + (uint64_t)header.outputSize +
+            header.debugDataSize + header.messageSize;
+        // Expired entries are dropped on the first store only; after that the
+        // directory is pruned when it grows past the limit.
+        if (firstStore || (maxSizeBytes != 0 && cacheSize.bytes > maxSizeBytes))
+        {
+            CachePruningPolicy policy;
+            policy.Interval = std::chrono::seconds(0);
+            policy.MaxSizePercentageOfAvailableSpace = 0;
+            policy.MaxSizeBytes = maxSizeBytes;
+            pruneCache(m_cacheDir, policy);
+            cacheSize.dir = m_cacheDir;
+            cacheSize.bytes = measureCache(m_cacheDir);
+        }
+    }
+
+    void ProgramCache::printStats(const char* event) const
+    {
+        if (IGC_IS_FLAG_DISABLED(ProgramCacheVerbose))
+        {
+            return;
+        }
+        fprintf(stderr, "IGC program cache %s: %s (hits %u, misses %u, stores %u, loaded %llu B, stored %llu B)\n",
+            event, m_entryPath.c_str(),
+            s_stats.hits.load(), s_stats.misses.load(), s_stats.stores.load(),
+            (unsigned long long)s_stats.bytesLoaded.load(),
+            (unsigned long long)s_stats.bytesStored.load());
+    }
+}
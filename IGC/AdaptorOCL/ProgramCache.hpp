@@ -0,0 +1,69 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "AdaptorOCL/TranslationBlock.h"
+#include "Compiler/CISACodeGen/Platform.hpp"
+
+#include <atomic>
+#include <string>
+
+namespace TC
+{
+    // Persistent, content addressed cache of final program binaries
+    // (patch-token or zebin) produced by TranslateBuild.
+    //
+    // The key covers everything that can change the output: the input
+    // module, build and internal options, specialization constants, the
+    // platform description (PLATFORM, SKU/WA tables, GT system info), the
+    // explicitly set IGC keys and the IGC revision.
+    //
+    // Entries are published atomically (written to a temporary file and
+    // renamed) so concurrent processes never observe partial entries. The
+    // directory is kept under ProgramCacheMaxSizeMB by evicting the least
+    // recently used entries; entries not used for a week expire. The
+    // directory is only scanned when the first entry of the process is
+    // stored and when the stored bytes push it over the limit.
+    class ProgramCache
+    {
+    public:
+        struct Stats
+        {
+            std::atomic<uint32_t> hits{ 0 };
+            std::atomic<uint32_t> misses{ 0 };
+            std::atomic<uint32_t> stores{ 0 };
+            std::atomic<uint64_t> bytesLoaded{ 0 };
+            std::atomic<uint64_t> bytesStored{ 0 };
+        };
+
+        ProgramCache(const STB_TranslateInputArgs* pInputArgs,
+                     TB_DATA_FORMAT inputDataFormat,
+                     const IGC::CPlatform& platform);
+
+        // False if the cache is disabled or the request cannot be cached
+        // (e.g. GTPin or tracing is requested).
+        bool isEnabled() const { return !m_entryPath.empty(); }
+
+        // On hit fills pOutput, pDebugData and pErrorString (warnings) of
+        // pOutputArgs with newly allocated buffers and returns true.
+        bool load(STB_TranslateOutputArgs* pOutputArgs);
+
+        // Publishes the result of a successful translation.
+        void store(const STB_TranslateOutputArgs* pOutputArgs);
+
+        static const Stats& getStats() { return s_stats; }
+
+    private:
+        void printStats(const char* event) const;
+
+        std::string m_cacheDir;
+        std::string m_entryPath;
+        static Stats s_stats;
+    };
+}
@@ -0,0 +1,67 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// This file defines an input stream reading SPIR-V words in place.
+
+#ifndef SPIRVMEMORYSTREAM_H
+#define SPIRVMEMORYSTREAM_H
+
+#include <cstddef>
+#include <istream>
+#include <streambuf>
+
+namespace igc_spv {
+
+// Read-only stream buffer over memory owned by the caller. Unlike
+// std::istringstream it does not copy the input, which matters for SPIR-V
+// modules of hundreds of megabytes. Seeking is supported because the decoder
+// rewinds over continued instructions.
+class SPIRVMemoryStreamBuf : public std::streambuf {
+public:
+  SPIRVMemoryStreamBuf(const char *Data, size_t Size) {
+    // The get area is never written through.
+    char *Begin = const_cast<char *>(Data);
+    setg(Begin, Begin, Begin + Size);
+  }
+
+protected:
+  pos_type seekoff(off_type Off, std::ios_base::seekdir Dir,
+                   std::ios_base::openmode Which) override {
+    if (!(Which & std::ios_base::in))
+      return pos_type(off_type(-1));
+    off_type Size = egptr() - eback();
+    off_type Base = Dir == std::ios_base::beg   ? 0
+                    : Dir == std::ios_base::cur ? gptr() - eback()
+                                                : Size;
+    off_type Pos = Base + Off;
+    if (Pos < 0 || Pos > Size)
+      return pos_type(off_type(-1));
+    setg(eback(), eback() + Pos, egptr());
+    return pos_type(Pos);
+  }
+
+  pos_type seekpos(pos_type Pos, std::ios_base::openmode Which) override {
+    return seekoff(off_type(Pos), std::ios_base::beg, Which);
+  }
+};
+
+// Input stream over a SPIR-V binary that must outlive the stream.
+class SPIRVMemoryStream : public std::istream {
+public:
+  SPIRVMemoryStream(const char *Data, size_t Size)
+      : std::istream(nullptr), Buf(Data, Size) {
+    rdbuf(&Buf);
+  }
+
+private:
+  SPIRVMemoryStreamBuf Buf;
+};
+
+} // namespace igc_spv
+
+#endif // SPIRVMEMORYSTREAM_H
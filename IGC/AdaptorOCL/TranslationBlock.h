@@ -217,6 +217,7 @@ struct STB_TranslateOutputArgs
     uint32_t    ErrorStringSize;    // size of error string
     char*       pDebugData;         // pointer to translated debug data buffer
     uint32_t    DebugDataSize;      // translated debug data data size (bytes)
+    bool        Tier0Binary;        // built by the tier-0 pipeline, worth recompiling
 
     STB_TranslateOutputArgs()
     {
@@ -226,6 +227,7 @@ struct STB_TranslateOutputArgs
         ErrorStringSize     = 0;
         pDebugData          = NULL;
         DebugDataSize       = 0;
+        Tier0Binary         = false;
     }
 };
 
@@ -211,7 +211,11 @@ static void CommonOCLBasedPasses(
 
     StringRef dataLayout = layoutstr;
     pContext->getModule()->setDataLayout(dataLayout);
-    BuiltinGenericModule->setDataLayout(dataLayout);
+    // Not loaded if the built-ins come from the BiF snapshot.
+    if( BuiltinGenericModule )
+    {
+        BuiltinGenericModule->setDataLayout(dataLayout);
+    }
     if( BuiltinSizeModule )
     {
         BuiltinSizeModule->setDataLayout(dataLayout);
@@ -27,8 +27,10 @@ SPDX-License-Identifier: MIT
 
 #include "AdaptorOCL/UnifyIROCL.hpp"
 #include "AdaptorOCL/DriverInfoOCL.hpp"
+#include "AdaptorOCL/ProgramCache.hpp"
 
 #include "Compiler/MetaDataApi/IGCMetaDataHelper.h"
+#include "Compiler/Optimizer/BuiltInFuncSnapshot.h"
 #include "common/debug/Dump.hpp"
 #include "common/debug/Debug.hpp"
 #include "common/igc_regkeys.hpp"
@@ -52,6 +54,7 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPush.hpp"
 #include "AdaptorOCL/SPIRV/SPIRVconsum.h"
 #include "common/LLVMWarningsPop.hpp"
+#include "AdaptorOCL/SPIRV/SPIRVMemoryStream.h"
 #include "AdaptorOCL/SPIRV/libSPIRV/SPIRVModule.h"
 #include "AdaptorOCL/SPIRV/libSPIRV/SPIRVValue.h"
 #if defined(IGC_SCALAR_USE_KHRONOS_SPIRV_TRANSLATOR)
@@ -415,7 +418,9 @@ bool TranslateSPIRVToLLVM(
     std::string& stringErrMsg)
 {
     bool success = true;
-    std::istringstream IS(SPIRVBinary.str());
+    // Read the words straight from the caller's buffer instead of copying
+    // the whole module into a string stream.
+    igc_spv::SPIRVMemoryStream IS(SPIRVBinary.data(), SPIRVBinary.size());
     std::unordered_map<uint32_t, uint64_t> specIDToSpecValueMap = UnpackSpecConstants(
         InputArgs.pSpecConstantsIds,
         InputArgs.pSpecConstantsValues,
@@ -945,6 +950,22 @@ static std::unique_ptr<llvm::MemoryBuffer> GetGenericModuleBuffer() {
     return std::unique_ptr<llvm::MemoryBuffer>{llvm::LoadBufferFromResource(Resource, "BC")};
 }
 
+static std::unique_ptr<llvm::MemoryBuffer> GetSizeTModuleBuffer(unsigned PtrSzInBits) {
+    char ResNumber[5] = { '-' };
+    switch (PtrSzInBits)
+    {
+    case 32:
+        _snprintf_s(ResNumber, sizeof(ResNumber), 5, "#%d", OCL_BC_32);
+        break;
+    case 64:
+        _snprintf_s(ResNumber, sizeof(ResNumber), 5, "#%d", OCL_BC_64);
+        break;
+    default:
+        IGC_ASSERT_MESSAGE(0, "Unknown bitness of compiled module");
+    }
+    return std::unique_ptr<llvm::MemoryBuffer>{llvm::LoadBufferFromResource(ResNumber, "BC")};
+}
+
 static void WriteSpecConstantsDump(const STB_TranslateInputArgs *pInputArgs,
                                    QWORD hash) {
     const char *pOutputFolder = IGC::Debug::GetShaderOutputFolder();
@@ -1086,6 +1107,7 @@ bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs,
 #endif // __GNUC__
 
     COMPILER_TIME_START(&oclContext, TIME_TOTAL);
+    oclContext.m_compileBudget.start(oclContext.m_InternalOptions.CompileTimeBudgetMs);
     oclContext.m_ProfilingTimerResolution = profilingTimerResolution;
 
     if(inputDataFormatTemp == TB_DATA_FORMAT_SPIR_V)
@@ -1184,8 +1206,22 @@ bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs,
                 // when linking M1 into M0 (M0 : dstModule, M1 : srcModule), the final type is the type
                 // used in M0.
 
+                if (IGC_IS_FLAG_ENABLED(EnableBiFSnapshot))
+                {
+                    // The snapshot is built on first use and shared by all
+                    // later compilations; BIImport extracts what it needs.
+                    COMPILER_TIME_START(&oclContext, TIME_OCL_LazyBiFLoading);
+                    oclContext.m_BiFSnapshot = IGC::BiFSnapshot::get(PtrSzInBits, [PtrSzInBits]() {
+                        IGC::BiFSnapshot::Buffers buffers;
+                        buffers.generic = GetGenericModuleBuffer();
+                        buffers.sizeT = GetSizeTModuleBuffer(PtrSzInBits);
+                        return buffers;
+                    });
+                    COMPILER_TIME_END(&oclContext, TIME_OCL_LazyBiFLoading);
+                }
+
                 // Load the builtin module -  Generic BC
-                // Load the builtin module -  Generic BC
+                if (oclContext.m_BiFSnapshot == nullptr)
                 {
                     COMPILER_TIME_START(&oclContext, TIME_OCL_LazyBiFLoading);
 
@@ -1221,22 +1257,10 @@ bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs,
                 }
 
                 // Load the builtin module -  pointer depended
+                if (oclContext.m_BiFSnapshot == nullptr)
                 {
-                    char ResNumber[5] = { '-' };
-                    switch (PtrSzInBits)
-                    {
-                    case 32:
-                        _snprintf_s(ResNumber, sizeof(ResNumber), 5, "#%d", OCL_BC_32);
-                        break;
-                    case 64:
-                        _snprintf_s(ResNumber, sizeof(ResNumber), 5, "#%d", OCL_BC_64);
-                        break;
-                    default:
-                        IGC_ASSERT_MESSAGE(0, "Unknown bitness of compiled module");
-                    }
-
                     // the MemoryBuffer becomes owned by the module and does not need to be managed
-                    pSizeTBuffer.reset(llvm::LoadBufferFromResource(ResNumber, "BC"));
+                    pSizeTBuffer = GetSizeTModuleBuffer(PtrSzInBits);
                     IGC_ASSERT_MESSAGE(pSizeTBuffer, "Error loading builtin resource");
 
                     llvm::Expected<std::unique_ptr<llvm::Module>> ModuleOrErr =
@@ -1249,8 +1273,11 @@ bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs,
                     IGC_ASSERT_MESSAGE(BuiltinSizeModule, "Error loading builtin module from buffer");
                 }
 
-                BuiltinGenericModule->setDataLayout(BuiltinSizeModule->getDataLayout());
-                BuiltinGenericModule->setTargetTriple(BuiltinSizeModule->getTargetTriple());
+                if (BuiltinGenericModule)
+                {
+                    BuiltinGenericModule->setDataLayout(BuiltinSizeModule->getDataLayout());
+                    BuiltinGenericModule->setTargetTriple(BuiltinSizeModule->getTargetTriple());
+                }
             }
 
             oclContext.getModuleMetaData()->csInfo.forcedSIMDSize |= IGC_GET_FLAG_VALUE(ForceOCLSIMDWidth);
@@ -1381,6 +1408,7 @@ bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs,
 
     pOutputArgs->OutputSize = binarySize;
     pOutputArgs->pOutput = binaryOutput;
+    pOutputArgs->Tier0Binary = oclContext.isTier0Compile();
 
     // Prepare and set program debug data
     size_t debugDataSize = 0;
@@ -1400,6 +1428,21 @@ bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs,
 
     COMPILER_TIME_DEL(&oclContext, m_compilerTimeStats);
 
+    if (oclContext.m_compileBudget.isEnabled())
+    {
+        std::vector<std::string> degradations;
+        for (uint32_t d = 1; d <= oclContext.m_compileBudget.getDegradations(); d <<= 1)
+        {
+            if (oclContext.m_compileBudget.getDegradations() & d)
+            {
+                degradations.push_back(
+                    CompileBudget::getDegradationName(static_cast<CompileBudget::Degradation>(d)));
+            }
+        }
+        oclContext.metrics.CollectCompileBudget(
+            oclContext.m_compileBudget.getBudgetMs(), oclContext.m_compileBudget.getElapsedMs(), degradations);
+    }
+
     oclContext.metrics.FinalizeStats();
     oclContext.metrics.OutputMetrics();
 
@@ -1436,7 +1479,7 @@ bool TranslateBuildVC(
 }
 #endif // defined(IGC_VC_ENABLED)
 
-bool TranslateBuild(
+static bool TranslateBuildUncached(
     const STB_TranslateInputArgs* pInputArgs,
     STB_TranslateOutputArgs* pOutputArgs,
     TB_DATA_FORMAT inputDataFormatTemp,
@@ -1480,6 +1523,28 @@ bool TranslateBuild(
 
 }
 
+bool TranslateBuild(
+    const STB_TranslateInputArgs* pInputArgs,
+    STB_TranslateOutputArgs* pOutputArgs,
+    TB_DATA_FORMAT inputDataFormatTemp,
+    const IGC::CPlatform& IGCPlatform,
+    float profilingTimerResolution)
+{
+    ProgramCache cache(pInputArgs, inputDataFormatTemp, IGCPlatform);
+    if (cache.isEnabled() && cache.load(pOutputArgs))
+    {
+        return true;
+    }
+
+    bool success = TranslateBuildUncached(pInputArgs, pOutputArgs, inputDataFormatTemp,
+                                          IGCPlatform, profilingTimerResolution);
+    if (success && cache.isEnabled())
+    {
+        cache.store(pOutputArgs);
+    }
+    return success;
+}
+
 bool CIGCTranslationBlock::FreeAllocations(
     STB_TranslateOutputArgs* pOutputArgs)
 {
@@ -37,6 +37,10 @@ CodeType::CodeType_t CIF_GET_INTERFACE_CLASS(OclTranslationOutput, 1)::GetOutput
   return CIF_GET_PIMPL()->GetOutputType();
 }
 
+bool CIF_GET_INTERFACE_CLASS(OclTranslationOutput, 2)::IsTier0Binary() const {
+  return CIF_GET_PIMPL()->IsTier0Binary();
+}
+
 }
 
 #include "cif/macros/disable.h"
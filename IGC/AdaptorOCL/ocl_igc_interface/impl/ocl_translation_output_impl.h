@@ -72,6 +72,16 @@ CIF_DECLARE_INTERFACE_PIMPL(OclTranslationOutput) : CIF::PimplBase
         return OutputType;
     }
 
+    bool IsTier0Binary() const
+    {
+        return Tier0Binary;
+    }
+
+    void SetTier0Binary(bool tier0Binary)
+    {
+        Tier0Binary = tier0Binary;
+    }
+
     bool SetError(TranslationErrorType::ErrorCode_t e, const char * errString = nullptr)
     {
         this->Error = e;
@@ -134,6 +144,7 @@ protected:
     CIF::Multiversion<CIF::Builtins::Buffer> DebugData;
     CodeType::CodeType_t OutputType;
     TranslationErrorType::ErrorCode_t  Error;
+    bool Tier0Binary = false;
 };
 
 CIF_DEFINE_INTERFACE_TO_PIMPL_FORWARDING_CTOR_DTOR(OclTranslationOutput);
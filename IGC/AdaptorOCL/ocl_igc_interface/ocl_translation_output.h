@@ -51,10 +51,23 @@ protected:
   virtual CIF::Builtins::BufferBase *GetDebugDataImpl(CIF::Version_t bufferVersion);
 };
 
+CIF_DEFINE_INTERFACE_VER_WITH_COMPATIBILITY(OclTranslationOutput, 2, 1) {
+  CIF_INHERIT_CONSTRUCTOR();
+
+  // True if the output was built by the low latency tier-0 pipeline
+  // (-cl-intel-tier0-compile). Such binaries are functional but not fully
+  // optimized; the runtime may translate the same input again without the
+  // option in the background and swap the binary once it is ready.
+  virtual bool IsTier0Binary() const;
+};
+
 CIF_GENERATE_VERSIONS_LIST_AND_DECLARE_INTERFACE_DEPENDENCIES(OclTranslationOutput, CIF::Builtins::Buffer);
 CIF_MARK_LATEST_VERSION(OclTranslationOutputLatest, OclTranslationOutput);
-using OclTranslationOutputTagOCL = OclTranslationOutputLatest; // Note : can tag with different version for
-                                                               //        transition periods
+using OclTranslationOutputTagOCL = OclTranslationOutput<1>; // transition time - remove this using
+                                                            // and uncomment the one below when finished
+
+//using OclTranslationOutputTagOCL = OclTranslationOutputLatest; // Note : can tag with different version for
+                                                                 //        transition periods
 
 }
 
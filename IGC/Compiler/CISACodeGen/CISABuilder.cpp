@@ -30,12 +30,18 @@ SPDX-License-Identifier: MIT
 #include <sstream>
 #include <string>
 #include <fstream>
+#include <future>
 #include "Probe/Assertion.h"
 
 #if !defined(_WIN32)
 #   define _strdup strdup
 #endif
 
+#if GET_TIME_STATS
+// Exposed by VISA lib API
+extern "C" void initThreadTimers();
+#endif
+
 /***********************************************************************************
 This file defines the CEncoder class which is used to generate CISA instructions
 ************************************************************************************/
@@ -4489,7 +4495,8 @@ namespace IGC
             SaveOption(vISA_Src1Src2OverlapWA, true);
         }
 
-        if (IGC_IS_FLAG_ENABLED(UseLinearScanRA))
+        if (IGC_IS_FLAG_ENABLED(UseLinearScanRA) ||
+            context->m_compileBudget.degrade(CompileBudget::DEGRADE_LINEAR_SCAN_RA, 75))
         {
             SaveOption(vISA_LinearScan, true);
         }
@@ -4764,6 +4771,14 @@ namespace IGC
             }
         }
 
+        // Tier-0 OpenCL compilation trades code quality for compile time.
+        if (context->isTier0Compile())
+        {
+            SaveOption(vISA_LinearScan, true);
+            SaveOption(vISA_NoRemat, true);
+            SaveOption(vISA_preRA_Schedule, false);
+        }
+
         if (context->getModuleMetaData()->compOpt.DisableIncSpillCostAllAddrTaken)
         {
             SaveOption(vISA_IncSpillCostAllAddrTaken, false);
@@ -4915,6 +4930,9 @@ namespace IGC
         }
 
         COMPILER_TIME_START(m_program->GetContext(), TIME_CG_vISACompile);
+#if GET_TIME_STATS
+        m_vISACompileStart = iSTD::GetTimestampCounter();
+#endif
         bool enableVISADump = IGC_IS_FLAG_ENABLED(EnableVISASlowpath) || IGC_IS_FLAG_ENABLED(ShaderDumpEnable);
         auto builderMode = m_hasInlineAsm ? vISA_ASM_WRITER : vISA_DEFAULT;
         auto builderOpt = (enableVISADump || m_hasInlineAsm) ? VISA_BUILDER_BOTH : VISA_BUILDER_GEN;
@@ -5632,6 +5650,11 @@ namespace IGC
 
         int vIsaCompile = 0;
         VISAKernel* pMainKernel = nullptr;
+#if GET_TIME_STATS
+        // VISA timers of a compile finished by the CompileAsync worker
+        VISATimerReadings asyncTimers;
+        bool asyncCompile = false;
+#endif
 
         // ShaderOverride for .visaasm files
         std::vector<std::string> visaOverrideFiles;
@@ -5826,6 +5849,16 @@ namespace IGC
             }
         }
         //Compile to generate the V-ISA binary
+        else if (m_pendingCompile.valid())
+        {
+            pMainKernel = vMainKernel;
+            AsyncCompileResult result = m_pendingCompile.get();
+            vIsaCompile = result.status;
+#if GET_TIME_STATS
+            asyncTimers = std::move(result.timers);
+            asyncCompile = true;
+#endif
+        }
         else
         {
             pMainKernel = vMainKernel;
@@ -5833,13 +5866,30 @@ namespace IGC
                 m_enableVISAdump ? GetDumpFileName("isa").c_str() : "");
         }
 
-        COMPILER_TIME_END(m_program->GetContext(), TIME_CG_vISACompile);
+#if GET_TIME_STATS
+        if (asyncCompile)
+        {
+            // other SIMD variants restarted the timer since this one was
+            // initialized, so time this variant from its own start
+            if (context->m_compilerTimeStats)
+            {
+                context->m_compilerTimeStats->recordTimerEnd(TIME_CG_vISACompile, m_vISACompileStart);
+            }
+        }
+        else
+#endif
+        {
+            COMPILER_TIME_END(m_program->GetContext(), TIME_CG_vISACompile);
+        }
 
 #if GET_TIME_STATS
         // handle the vISA time counters differently here
         if (context->m_compilerTimeStats)
         {
-            context->m_compilerTimeStats->recordVISATimers();
+            // builder API timers ran on this thread, the finalization on the worker
+            VISATimerReadings timers = VISATimerReadings::read();
+            timers.add(asyncTimers);
+            context->m_compilerTimeStats->recordVISATimers(timers);
         }
 #endif
         KERNEL_INFO* vISAstats;
@@ -6172,8 +6222,56 @@ namespace IGC
         pOutput->m_numThreads = jitInfo->numThreads;
     }
 
+    bool CEncoder::CompileAsync()
+    {
+        IGC_ASSERT(nullptr != m_program);
+        CodeGenContext* const context = m_program->GetContext();
+        // Inline vISA, vISA linking and overrides go through a second builder
+        // whose setup touches the LLVM module, so keep them on this thread.
+        if (m_hasInlineAsm ||
+            IsCodePatchCandidate() ||
+            HasPrevKernel() ||
+            IGC_IS_FLAG_ENABLED(ShaderOverride) ||
+            (context->type == ShaderType::OPENCL_SHADER &&
+             !static_cast<OpenCLProgramContext*>(context)->m_VISAAsmToLink.empty()))
+        {
+            return false;
+        }
+
+        // The builder is only used by the worker until Compile() or
+        // DiscardPendingCompile() joins it.
+        VISABuilder* builder = vbuilder;
+        std::string isaName = m_enableVISAdump ? GetDumpFileName("isa") : "";
+        m_pendingCompile = std::async(std::launch::async, [builder, isaName]() {
+            AsyncCompileResult result;
+#if GET_TIME_STATS
+            initThreadTimers();
+#endif
+            result.status = builder->Compile(isaName.c_str());
+#if GET_TIME_STATS
+            result.timers = VISATimerReadings::read();
+#endif
+            return result;
+        });
+#if GET_TIME_STATS
+        // The time is recorded when Compile() joins the worker. Close the
+        // trace interval here, later SIMD variants open their own.
+        ::IGC::TraceEvents::end(g_cCompTimeIntervals[TIME_CG_vISACompile], "IGC");
+#endif
+        return true;
+    }
+
+    void CEncoder::DiscardPendingCompile()
+    {
+        if (m_pendingCompile.valid())
+        {
+            m_pendingCompile.get();
+        }
+    }
+
     void CEncoder::DestroyVISABuilder()
     {
+        DiscardPendingCompile();
         if (vAsmTextBuilder != nullptr)
         {
             V(::DestroyVISABuilder(vAsmTextBuilder));
@@ -15,6 +15,8 @@ SPDX-License-Identifier: MIT
 #include "visa_wa.h"
 #include "inc/common/sku_wa.h"
 
+#include <future>
+
 namespace IGC
 {
     class CShader;
@@ -133,6 +135,13 @@ namespace IGC
         void MarkAsOutput(CVariable* var);
         void MarkAsPayloadLiveOut(CVariable* var);
         void Compile(bool hasSymbolTable = false);
+        /// \brief Starts vISA finalization of the kernel on a worker thread.
+        /// A later Compile() call waits for it and collects the result. Returns
+        /// false if the kernel has to be finalized synchronously.
+        bool CompileAsync();
+        bool HasPendingCompile() const { return m_pendingCompile.valid(); }
+        /// \brief Waits for a speculative compile whose result is not needed.
+        void DiscardPendingCompile();
         std::string GetShaderName();
         void ReportCompilerStatistics(VISAKernel* pMainKernel, SProgramOutput* pOutput);
         int GetThreadCount(SIMDMode simdMode);
@@ -714,6 +723,21 @@ namespace IGC
         bool m_enableVISAdump = false;
         bool m_hasInlineAsm = false;
 
+        // vISA finalization running on a worker thread (see CompileAsync)
+        struct AsyncCompileResult
+        {
+            int status;
+#if GET_TIME_STATS
+            // the worker's VISA timers, they are thread local
+            VISATimerReadings timers;
+#endif
+        };
+        std::future<AsyncCompileResult> m_pendingCompile;
+#if GET_TIME_STATS
+        // start of TIME_CG_vISACompile for this encoder
+        uint64_t m_vISACompileStart = 0;
+#endif
+
         std::vector<VISA_LabelOpnd*> labelMap;
         std::vector<CName> labelNameMap; // parallel to labelMap
 
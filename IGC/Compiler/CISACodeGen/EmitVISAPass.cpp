@@ -40,6 +40,7 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPush.hpp"
 #include "llvmWrapper/IR/Instructions.h"
 #include "llvmWrapper/IR/DerivedTypes.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/IR/AssemblyAnnotationWriter.h"
@@ -582,6 +583,15 @@ bool EmitPass::runOnFunction(llvm::Function& F)
     {
         return false;
     }
+
+    // With speculative SIMD codegen the wider variants of F are still being
+    // finalized; the pass for the narrowest variant picks the winner.
+    auto joinSpeculative = llvm::make_scope_exit([&]() {
+        if (m_pCtx->m_speculativeSIMD && m_SimdMode == m_pCtx->platform.getMinDispatchMode())
+        {
+            joinSpeculativeSIMD(F);
+        }
+    });
     m_moduleMD = getAnalysis<MetaDataUtilsWrapper>().getModuleMetaData();
 
     CreateKernelShaderMap(m_pCtx, pMdUtils, F);
@@ -611,6 +621,9 @@ bool EmitPass::runOnFunction(llvm::Function& F)
         return false;
     }
 
+    TraceEvents::Scope traceScope(TraceEvents::isEnabled() ?
+        F.getName().str() + " SIMD" + std::to_string(numLanes(m_SimdMode)) : std::string(), "kernel");
+
     bool isDummyKernel = IGC::isIntelSymbolTableVoidProgram(&F);
 
     // Dummy program is only used for symbol table info, so skip compilation if no symbol table is needed
@@ -1195,6 +1208,18 @@ bool EmitPass::runOnFunction(llvm::Function& F)
         }
         if (!skipPrologue)
         {
+            // Only single kernels without function calls are compiled
+            // speculatively, see joinSpeculativeSIMD.
+            if (m_pCtx->m_speculativeSIMD &&
+                !compileWithSymbolTable &&
+                !m_currShader->GetDebugInfoData().m_pDebugEmitter &&
+                (!m_FGA || m_FGA->getGroup(&F) == nullptr || m_FGA->getGroup(&F)->isSingle()) &&
+                !m_currShader->HasStackCalls() &&
+                m_encoder->CompileAsync())
+            {
+                IDebugEmitter::Release(m_pDebugEmitter);
+                return false;
+            }
             m_encoder->Compile(compileWithSymbolTable);
         }
         m_pCtx->m_prevShader = m_currShader;
@@ -1223,24 +1248,7 @@ bool EmitPass::runOnFunction(llvm::Function& F)
         }
     }
 
-    if ((m_currShader->GetShaderType() == ShaderType::COMPUTE_SHADER ||
-        m_currShader->GetShaderType() == ShaderType::OPENCL_SHADER) &&
-        m_currShader->m_Platform->supportDisableMidThreadPreemptionSwitch() &&
-        IGC_IS_FLAG_ENABLED(EnableDisableMidThreadPreemptionOpt) &&
-        (m_currShader->GetContext()->m_instrTypes.numLoopInsts == 0) &&
-        (m_currShader->ProgramOutput()->m_InstructionCount < IGC_GET_FLAG_VALUE(MidThreadPreemptionDisableThreshold)))
-    {
-        if (m_currShader->GetShaderType() == ShaderType::COMPUTE_SHADER)
-        {
-            CComputeShader* csProgram = static_cast<CComputeShader*>(m_currShader);
-            csProgram->SetDisableMidthreadPreemption();
-        }
-        else
-        {
-            COpenCLKernel* kernel = static_cast<COpenCLKernel*>(m_currShader);
-            kernel->SetDisableMidthreadPreemption();
-        }
-    }
+    updateMidThreadPreemption(m_currShader);
 
     if (IGC_IS_FLAG_ENABLED(ForceBestSIMD))
     {
@@ -1264,6 +1272,72 @@ bool EmitPass::runOnFunction(llvm::Function& F)
     return false;
 }
 
+void EmitPass::joinSpeculativeSIMD(llvm::Function& F)
+{
+    auto Iter = m_shaders.find(&F);
+    if (Iter == m_shaders.end())
+    {
+        return;
+    }
+
+    // Same order as the serial pipeline: a variant is used only if every
+    // wider one aborted on spill. Narrower variants compiled in the meantime
+    // are dropped as if they had never been tried.
+    bool selected = false;
+    for (SIMDMode mode : { SIMDMode::SIMD32, SIMDMode::SIMD16, SIMDMode::SIMD8 })
+    {
+        CShader* shader = Iter->second->GetShader(mode);
+        if (!shader)
+        {
+            continue;
+        }
+        CEncoder& encoder = shader->GetEncoder();
+        if (!encoder.HasPendingCompile())
+        {
+            selected |= shader->ProgramOutput()->m_programSize > 0;
+            continue;
+        }
+
+        if (selected)
+        {
+            encoder.DiscardPendingCompile();
+            m_pCtx->ClearSIMDInfo(mode, ShaderDispatchMode::NOT_APPLICABLE);
+        }
+        else
+        {
+            encoder.Compile();
+            selected = shader->ProgramOutput()->m_programSize > 0;
+            if (selected)
+            {
+                updateMidThreadPreemption(shader);
+            }
+        }
+        encoder.DestroyVISABuilder();
+    }
+}
+
+void EmitPass::updateMidThreadPreemption(CShader* shader)
+{
+    if ((shader->GetShaderType() == ShaderType::COMPUTE_SHADER ||
+        shader->GetShaderType() == ShaderType::OPENCL_SHADER) &&
+        shader->m_Platform->supportDisableMidThreadPreemptionSwitch() &&
+        IGC_IS_FLAG_ENABLED(EnableDisableMidThreadPreemptionOpt) &&
+        (shader->GetContext()->m_instrTypes.numLoopInsts == 0) &&
+        (shader->ProgramOutput()->m_InstructionCount < IGC_GET_FLAG_VALUE(MidThreadPreemptionDisableThreshold)))
+    {
+        if (shader->GetShaderType() == ShaderType::COMPUTE_SHADER)
+        {
+            CComputeShader* csProgram = static_cast<CComputeShader*>(shader);
+            csProgram->SetDisableMidthreadPreemption();
+        }
+        else
+        {
+            COpenCLKernel* kernel = static_cast<COpenCLKernel*>(shader);
+            kernel->SetDisableMidthreadPreemption();
+        }
+    }
+}
+
 // Emit code in slice starting from (reverse) iterator I. Return the iterator to
 // the next pattern to emit.
 SBasicBlock::reverse_iterator
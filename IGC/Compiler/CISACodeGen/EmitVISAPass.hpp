@@ -706,6 +706,13 @@ public:
     /// check if symbol table is needed
     bool isSymbolTableRequired(llvm::Function* F);
 
+    /// finish the speculatively compiled SIMD variants of F and keep the
+    /// widest one that did not abort on spill
+    void joinSpeculativeSIMD(llvm::Function& F);
+
+    /// disable mid-thread preemption for short loop-free kernels
+    void updateMidThreadPreemption(CShader* shader);
+
     // Arithmetic operations with constant folding
     // Src0 and Src1 are the input operands
     // DstPrototype is a prototype of the result of operation and may be used for cloning to a new variable
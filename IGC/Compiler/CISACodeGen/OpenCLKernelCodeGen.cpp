@@ -2317,7 +2317,9 @@ namespace IGC
             ctx->m_retryManager.IsLastTry() ||
             (!ctx->m_retryManager.kernelSkip.empty() &&
              ctx->m_retryManager.kernelSkip.count(pFunc->getName().str())) ||
-            optDisable)
+            optDisable ||
+            ctx->isTier0Compile() ||
+            ctx->m_compileBudget.degrade(CompileBudget::DEGRADE_RETRY, 50))
         {
             // Save the shader program to the state processor to be handled later
             if (ctx->m_programOutput.m_ShaderProgramList.size() == 0 ||
@@ -2527,6 +2529,23 @@ namespace IGC
             );
         }
 
+        // Tier-0 picks the SIMD width up front: the required sub-group size,
+        // or else the narrowest width the platform dispatches. Sub-group sizes
+        // below the dispatch width keep the regular selection.
+        if (m_Context->isTier0Compile())
+        {
+            MetaDataUtils* pMdUtils = EP.getAnalysis<MetaDataUtilsWrapper>().getMetaDataUtils();
+            llvm::Function* Kernel = m_FGA && m_FGA->getGroup(&F) ? m_FGA->getGroup(&F)->getHead() : &F;
+            unsigned requiredLanes = pMdUtils->getFunctionsInfoItem(Kernel)->getSubGroupSize()->getSIMD_size();
+            SIMDMode minMode = m_Context->platform.getMinDispatchMode();
+            SIMDMode tier0Mode = requiredLanes ? lanesToSIMDMode(requiredLanes) : minMode;
+            if (numLanes(tier0Mode) >= numLanes(minMode) && simdMode != tier0Mode)
+            {
+                m_Context->SetSIMDInfo(SIMD_SKIP_PERF, simdMode, ShaderDispatchMode::NOT_APPLICABLE);
+                return false;
+            }
+        }
+
         SIMDStatus simdStatus = checkSIMDCompileConds(simdMode, EP, F);
 
         if (m_Context->platform.getMinDispatchMode() == SIMDMode::SIMD16)
@@ -2534,6 +2553,19 @@ namespace IGC
             simdStatus = checkSIMDCompileCondsPVC(simdMode, EP, F);
         }
 
+        // Over half of the compile time budget is gone: SIMD32 is only tried
+        // when the kernel requires it.
+        if (simdMode == SIMDMode::SIMD32 && simdStatus != SIMDStatus::SIMD_FUNC_FAIL)
+        {
+            MetaDataUtils* pMdUtils = EP.getAnalysis<MetaDataUtilsWrapper>().getMetaDataUtils();
+            FunctionInfoMetaDataHandle funcInfoMD = pMdUtils->getFunctionsInfoItem(&F);
+            if (funcInfoMD->getSubGroupSize()->getSIMD_size() != 32 &&
+                m_Context->m_compileBudget.degrade(CompileBudget::DEGRADE_SIMD32, 50))
+            {
+                return false;
+            }
+        }
+
         // Func and Perf checks pass, compile this SIMD
         if (simdStatus == SIMDStatus::SIMD_PASS)
             return true;
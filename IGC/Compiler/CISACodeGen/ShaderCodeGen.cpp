@@ -1447,6 +1447,16 @@ void CodeGen(OpenCLProgramContext* ctx, CShaderProgram::KernelShaderMap& kernels
 
     AddAnalysisPasses(*ctx, Passes);
 
+    // Speculation keeps the serial selection order (widest variant that does
+    // not abort on spill), so it is only used when one variant is picked.
+    ctx->m_speculativeSIMD =
+        IGC_IS_FLAG_ENABLED(SpeculativeSIMDCodeGen) &&
+        IGC_IS_FLAG_DISABLED(ForceBestSIMD) &&
+        ctx->m_CgFlag == FLAG_CG_ALL_SIMDS &&
+        !ctx->m_enableFunctionPointer &&
+        !ctx->m_DriverInfo.sendMultipleSIMDModes() &&
+        ctx->getModuleMetaData()->csInfo.forcedSIMDSize == 0;
+
     if (ctx->m_enableFunctionPointer
         && (ctx->m_DriverInfo.sendMultipleSIMDModes() || ctx->m_enableSimdVariantCompilation)
         && ctx->getModuleMetaData()->csInfo.forcedSIMDSize == 0)
@@ -1722,6 +1732,44 @@ static void alwaysInlineForNoOpt(CodeGenContext* pContext, bool NoOpt)
     }
 }
 
+// Tier-0 pipeline: only the inlining and local cleanups that codegen time
+// benefits from. Loop, global value numbering and control flow
+// optimizations are left to the full recompile.
+static void OptimizeIRTier0(CodeGenContext* pContext)
+{
+    COMPILER_TIME_START(pContext, TIME_OptimizationPasses);
+    {
+        unify_opt_PreProcess(pContext);
+
+        TargetLibraryInfoImpl TLI;
+        TLI.disableAllFunctions();
+
+        IGCPassManager mpm(pContext, "OPTTier0");
+        mpm.add(new MetaDataUtilsWrapper(pContext->getMetaDataUtils(), pContext->getModuleMetaData()));
+        mpm.add(new CodeGenContextWrapper(pContext));
+        mpm.add(new llvm::TargetLibraryInfoWrapperPass(TLI));
+        mpm.add(createAlwaysInlinerLegacyPass());
+        mpm.add(createSROAPass());
+        mpm.add(llvm::createEarlyCSEPass());
+        mpm.add(createIGCInstructionCombiningPass());
+        if (pContext->type == ShaderType::OPENCL_SHADER &&
+            static_cast<OpenCLProgramContext*>(pContext)->m_InternalOptions.KernelDebugEnable)
+        {
+            mpm.add(new ImplicitGIDRestoring());
+        }
+        mpm.add(llvm::createCFGSimplificationPass());
+        mpm.add(llvm::createDeadCodeEliminationPass());
+        if (!IGC::ForceAlwaysInline())
+        {
+            mpm.add(new PurgeMetaDataUtils());
+        }
+        mpm.run(*pContext->getModule());
+    }
+    COMPILER_TIME_END(pContext, TIME_OptimizationPasses);
+
+    DumpLLVMIR(pContext, "optimized");
+    MEM_SNAPSHOT(IGC::SMS_AFTER_OPTIMIZER);
+}
 
 void OptimizeIR(CodeGenContext* const pContext)
 {
@@ -1746,6 +1794,12 @@ void OptimizeIR(CodeGenContext* const pContext)
         return;
     }
 
+    if (pContext->isTier0Compile())
+    {
+        OptimizeIRTier0(pContext);
+        return;
+    }
+
     IGCPassManager mpm(pContext, "OPT");
 
 #if defined(_DEBUG) || defined(_INTERNAL)
@@ -1939,7 +1993,8 @@ void OptimizeIR(CodeGenContext* const pContext)
                 }
 
                 if (IGC_IS_FLAG_ENABLED(EnableCustomLoopVersioning) &&
-                    pContext->type == ShaderType::PIXEL_SHADER)
+                    pContext->type == ShaderType::PIXEL_SHADER &&
+                    !pContext->m_compileBudget.degrade(CompileBudget::DEGRADE_EXPENSIVE_OPTS, 25))
                 {
                     // custom loop versioning relies on LCSSA form
                     mpm.add(new CustomLoopVersioning());
@@ -1953,7 +2008,8 @@ void OptimizeIR(CodeGenContext* const pContext)
                 }
                 if (IGC_IS_FLAG_ENABLED(EnableAdvCodeMotion) &&
                     pContext->type == ShaderType::OPENCL_SHADER &&
-                    !pContext->m_instrTypes.hasSwitch)
+                    !pContext->m_instrTypes.hasSwitch &&
+                    !pContext->m_compileBudget.degrade(CompileBudget::DEGRADE_EXPENSIVE_OPTS, 25))
                 {
                     mpm.add(createAdvCodeMotionPass(IGC_GET_FLAG_VALUE(AdvCodeMotionControl)));
                 }
@@ -39,12 +39,13 @@ namespace {
             type = STATS_COUNTER_ENUM_TYPE;
         }
 
-        TimeStatsCounter(CodeGenContext* _ctx, std::string _igcPass, TimeStatsCounterStartEndMode _mode) : ModulePass(ID) {
+        TimeStatsCounter(CodeGenContext* _ctx, std::string _igcPass, TimeStatsCounterStartEndMode _mode,
+            TimeStatsCounterType _type = STATS_COUNTER_LLVM_PASS) : ModulePass(ID) {
             initializeTimeStatsCounterPass(*PassRegistry::getPassRegistry());
             ctx = _ctx;
             mode = _mode;
             igcPass = _igcPass;
-            type = STATS_COUNTER_LLVM_PASS;
+            type = _type;
         }
 
         bool runOnModule(Module&) override;
@@ -63,6 +64,11 @@ ModulePass* IGC::createTimeStatsIGCPass(CodeGenContext* _ctx, std::string _igcPa
     return new TimeStatsCounter(_ctx, _igcPass, _mode);
 }
 
+ModulePass* IGC::createTraceEventPass(CodeGenContext* _ctx, std::string _name, TimeStatsCounterStartEndMode _mode)
+{
+    return new TimeStatsCounter(_ctx, _name, _mode, STATS_COUNTER_TRACE_EVENT);
+}
+
 char TimeStatsCounter::ID = 0;
 
 #define PASS_FLAG     "time-stats-counter"
@@ -86,6 +92,17 @@ bool TimeStatsCounter::runOnModule(Module& F) {
             COMPILER_TIME_END(ctx, interval);
         }
     }
+    else if (type == STATS_COUNTER_TRACE_EVENT)
+    {
+        if (mode == STATS_COUNTER_START)
+        {
+            TraceEvents::begin(igcPass.c_str(), "LLVM pass");
+        }
+        else
+        {
+            TraceEvents::end(igcPass.c_str(), "LLVM pass");
+        }
+    }
     else
     {
         if (mode == STATS_COUNTER_START)
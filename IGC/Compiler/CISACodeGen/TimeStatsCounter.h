@@ -25,10 +25,12 @@ namespace IGC {
     enum TimeStatsCounterType
     {
         STATS_COUNTER_LLVM_PASS,
-        STATS_COUNTER_ENUM_TYPE
+        STATS_COUNTER_ENUM_TYPE,
+        STATS_COUNTER_TRACE_EVENT
     };
 
     llvm::ModulePass* createTimeStatsCounterPass(CodeGenContext* _ctx, COMPILE_TIME_INTERVALS _interval, TimeStatsCounterStartEndMode _mode);
     llvm::ModulePass* createTimeStatsIGCPass(CodeGenContext* _ctx, std::string _igcPass, TimeStatsCounterStartEndMode _mode);
+    llvm::ModulePass* createTraceEventPass(CodeGenContext* _ctx, std::string _name, TimeStatsCounterStartEndMode _mode);
     void initializeTimeStatsCounterPass(llvm::PassRegistry&);
 } // End namespace IGC
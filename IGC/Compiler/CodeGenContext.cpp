@@ -39,6 +39,41 @@ namespace IGC
         { false, true, true, true, false, false, false, false, false, 500 }
     };
 
+    void CompileBudget::start(uint32_t budgetMs)
+    {
+        m_budgetMs = budgetMs;
+        m_degradations = 0;
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    uint32_t CompileBudget::getElapsedMs() const
+    {
+        return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    bool CompileBudget::degrade(Degradation d, unsigned percent)
+    {
+        if (!isEnabled() || (uint64_t)getElapsedMs() * 100 < (uint64_t)m_budgetMs * percent)
+        {
+            return false;
+        }
+        m_degradations |= d;
+        return true;
+    }
+
+    const char* CompileBudget::getDegradationName(Degradation d)
+    {
+        switch (d)
+        {
+        case DEGRADE_EXPENSIVE_OPTS: return "expensive-opts";
+        case DEGRADE_SIMD32:         return "simd32";
+        case DEGRADE_RETRY:          return "retry";
+        case DEGRADE_LINEAR_SCAN_RA: return "linear-scan-ra";
+        }
+        return "unknown";
+    }
+
     RetryManager::RetryManager() : enabled(false), perKernel(false)
     {
         memset(m_simdEntries, 0, sizeof(m_simdEntries));
@@ -610,6 +645,11 @@ namespace IGC
         return val;
     }
 
+    bool OpenCLProgramContext::isTier0Compile() const
+    {
+        return m_InternalOptions.Tier0Compile;
+    }
+
     void OpenCLProgramContext::InternalOptions::parseOptions(const char* IntOptStr)
     {
         // Assume flags is in the form: <f0>[=<v0>] <f1>[=<v1>] ...
@@ -876,6 +916,30 @@ namespace IGC
                 Pos = valEnd;
                 continue;
             }
+            // -cl-intel-compile-time-budget=<ms>, -ze-intel-compile-time-budget=<ms>
+            else if (suffix.equals("-compile-time-budget"))
+            {
+                size_t valStart = opts.find_first_not_of(' ', ePos + 1);
+                size_t valEnd = opts.find_first_of(' ', valStart);
+                llvm::StringRef valStr = opts.substr(valStart, valEnd - valStart);
+
+                if (valStr.getAsInteger(10, CompileTimeBudgetMs))
+                {
+                    IGC_ASSERT_MESSAGE(false, "-cl-intel-compile-time-budget: invalid value, ignored!");
+                    CompileTimeBudgetMs = 0;
+                }
+                Pos = valEnd;
+                continue;
+            }
+            // -cl-intel-tier0-compile, -ze-intel-tier0-compile
+            else if (suffix.equals("-tier0-compile"))
+            {
+                // Minimal LLVM pipeline, a single SIMD width per kernel,
+                // linear scan RA and no rematerialization. The output is
+                // marked as tier-0 so that the runtime can request a full
+                // recompile in the background.
+                Tier0Compile = true;
+            }
             // -cl-intel-allow-zebin
             else if (suffix.equals("-allow-zebin"))
             {
@@ -1315,6 +1379,11 @@ namespace IGC
         return 0;
     }
 
+    bool CodeGenContext::isTier0Compile() const
+    {
+        return false;
+    }
+
     bool CodeGenContext::isPOSH() const
     {
         return this->getModule()->getModuleFlag(
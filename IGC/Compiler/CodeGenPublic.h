@@ -55,6 +55,7 @@ SPDX-License-Identifier: MIT
 #include <unordered_set>
 #include "Probe/Assertion.h"
 #include <optional>
+#include <chrono>
 #include <Metrics/IGCMetric.h>
 
 /************************************************************************
@@ -76,6 +77,7 @@ namespace IGC
     class CodeGenContext;
     class PixelShaderContext;
     class ComputeShaderContext;
+    class BiFSnapshot;
 
     struct SProgramOutput
     {
@@ -946,6 +948,36 @@ namespace IGC
         USC::SShaderStageBTLayout* getModifiableLayout();
     };
 
+    /// Wall clock budget of a translation (-cl-intel-compile-time-budget).
+    /// Phases of the pipeline consult it at their boundaries and fall back to
+    /// cheaper code generation once their share of the budget is used up.
+    class CompileBudget
+    {
+    public:
+        enum Degradation : uint32_t
+        {
+            DEGRADE_EXPENSIVE_OPTS = 1 << 0,   // skip AdvCodeMotion, CustomLoopVersioning
+            DEGRADE_SIMD32         = 1 << 1,   // skip optional SIMD32 trials
+            DEGRADE_RETRY          = 1 << 2,   // keep spilling kernels instead of retrying
+            DEGRADE_LINEAR_SCAN_RA = 1 << 3,   // use linear scan instead of graph coloring RA
+        };
+
+        void start(uint32_t budgetMs);
+        bool isEnabled() const { return m_budgetMs != 0; }
+        uint32_t getBudgetMs() const { return m_budgetMs; }
+        uint32_t getElapsedMs() const;
+        /// Returns true and records d if more than percent of the budget has
+        /// elapsed. Callers take the degradation when it returns true.
+        bool degrade(Degradation d, unsigned percent);
+        uint32_t getDegradations() const { return m_degradations; }
+        static const char* getDegradationName(Degradation d);
+
+    private:
+        uint32_t m_budgetMs = 0;
+        uint32_t m_degradations = 0;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
     class RetryManager
     {
     public:
@@ -1091,6 +1123,7 @@ namespace IGC
         llvm::AssemblyAnnotationWriter* annotater = nullptr;
 
         RetryManager m_retryManager;
+        CompileBudget m_compileBudget;
 
         IGCMetrics::IGCMetric metrics;
 
@@ -1106,6 +1139,9 @@ namespace IGC
 
         // Record previous simd for code patching
         CShader* m_prevShader = nullptr;
+        // SIMD variants of a kernel are finalized concurrently and the winner is
+        // picked once all of them are done (SpeculativeSIMDCodeGen)
+        bool m_speculativeSIMD = false;
 
         // For IR dump after pass
         unsigned     m_numPasses = 0;
@@ -1252,6 +1288,7 @@ namespace IGC
         virtual bool hasNoPrivateToGenericCast() const;
         virtual bool enableTakeGlobalAddress() const;
         virtual int16_t getVectorCoalescingControl() const;
+        virtual bool isTier0Compile() const;
         bool isPOSH() const;
 
         CompilerStats& Stats()
@@ -1746,6 +1783,13 @@ namespace IGC
             // 0-5: valid values set from the cmdline
             int16_t VectorCoalescingControl = -1;
 
+            // Compile time budget in milliseconds, 0 means unlimited
+            uint32_t CompileTimeBudgetMs = 0;
+
+            // Tier-0 compilation: low latency pipeline, the runtime is
+            // expected to request a full recompile in the background
+            bool Tier0Compile = false;
+
             bool Intel128GRFPerThread = false;
             bool Intel256GRFPerThread = false;
             bool IntelNumThreadPerEU = false;
@@ -1843,6 +1887,10 @@ namespace IGC
         // Additional text visaasm to link.
         std::vector<const char*> m_VISAAsmToLink;
 
+        // When set, BIImport takes the built-ins from this process-wide
+        // snapshot instead of from lazily loaded generic/size_t modules.
+        const BiFSnapshot* m_BiFSnapshot = nullptr;
+
         OpenCLProgramContext(
             const COCLBTILayout& btiLayout,
             const CPlatform& platform,
@@ -1875,6 +1923,7 @@ namespace IGC
         bool hasNoPrivateToGenericCast() const override;
         bool enableTakeGlobalAddress() const override;
         int16_t getVectorCoalescingControl() const override;
+        bool isTier0Compile() const override;
     private:
         llvm::DenseMap<llvm::Function*, std::string> m_hashes_per_kernel;
     };
@@ -7,6 +7,7 @@ SPDX-License-Identifier: MIT
 ============================= end_copyright_notice ===========================*/
 
 #include "Compiler/Optimizer/BuiltInFuncImport.h"
+#include "Compiler/Optimizer/BuiltInFuncSnapshot.h"
 #include "Compiler/MetaDataApi/IGCMetaDataHelper.h"
 #include "Compiler/IGCPassSupport.h"
 #include "Compiler/CodeGenPublic.h"
@@ -472,9 +473,18 @@ std::unique_ptr<llvm::Module> BIImport::Construct(Module& M, CLElfLib::CElfReade
 
 bool BIImport::runOnModule(Module& M)
 {
+    const BiFSnapshot* pSnapshot = nullptr;
     if (m_GenericModule == nullptr)
     {
-        return false;
+        CodeGenContext* pCtx = getAnalysis<CodeGenContextWrapper>().getCodeGenContext();
+        if (pCtx->type == ShaderType::OPENCL_SHADER)
+        {
+            pSnapshot = static_cast<OpenCLProgramContext*>(pCtx)->m_BiFSnapshot;
+        }
+        if (pSnapshot == nullptr)
+        {
+            return false;
+        }
     }
 
 
@@ -512,6 +522,29 @@ bool BIImport::runOnModule(Module& M)
         }
     }
 
+    if (pSnapshot)
+    {
+        // Every built-in the module may call is declared by now, so the
+        // snapshot only has to hand out what is reachable from these.
+        std::vector<std::string> declNames;
+        for (auto& F : M)
+        {
+            if (F.isDeclaration())
+            {
+                declNames.push_back(F.getName().str());
+            }
+        }
+        BiFSnapshot::Slice slice = pSnapshot->extract(declNames, M.getContext());
+        if (slice.generic == nullptr)
+        {
+            return false;
+        }
+        m_GenericModule = std::move(slice.generic);
+        m_SizeModule = std::move(slice.sizeT);
+        m_GenericModule->setDataLayout(M.getDataLayout());
+        m_SizeModule->setDataLayout(M.getDataLayout());
+    }
+
     std::function<void(Function*)> Explore = [&](Function* pRoot) -> void
     {
         TFunctionsVec calledFuncs;
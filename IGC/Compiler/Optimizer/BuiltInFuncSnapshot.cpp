@@ -0,0 +1,352 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "Compiler/Optimizer/BuiltInFuncSnapshot.h"
+
+#include "common/LLVMWarningsPush.hpp"
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include "llvmWrapper/Bitcode/BitcodeWriter.h"
+#include "common/LLVMWarningsPop.hpp"
+
+#include "common/igc_regkeys.hpp"
+#include "Probe/Assertion.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+using namespace llvm;
+using namespace IGC;
+
+BiFSnapshot::Stats BiFSnapshot::s_stats;
+
+static uint64_t microsecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+const BiFSnapshot* BiFSnapshot::get(unsigned pointerSizeInBits, const std::function<Buffers()>& load)
+{
+    static std::mutex snapshotsMutex;
+    static std::map<unsigned, std::unique_ptr<BiFSnapshot>> snapshots;
+
+    std::lock_guard<std::mutex> lock(snapshotsMutex);
+    auto it = snapshots.find(pointerSizeInBits);
+    if (it == snapshots.end())
+    {
+        std::unique_ptr<BiFSnapshot> snapshot(new BiFSnapshot());
+        if (snapshot->init(load()))
+        {
+            s_stats.snapshots++;
+        }
+        else
+        {
+            snapshot.reset();
+        }
+        // A failure is remembered too, so that the resources are not reparsed.
+        it = snapshots.emplace(pointerSizeInBits, std::move(snapshot)).first;
+    }
+    return it->second.get();
+}
+
+bool BiFSnapshot::init(Buffers buffers)
+{
+    if (!buffers.generic || !buffers.sizeT)
+    {
+        return false;
+    }
+
+    const auto loadStart = std::chrono::steady_clock::now();
+    m_bitcodeBytes = buffers.generic->getBufferSize() + buffers.sizeT->getBufferSize();
+    std::unique_ptr<MemoryBuffer> moduleBuffers[NUM_MODULES] = {
+        std::move(buffers.generic), std::move(buffers.sizeT) };
+    for (unsigned m = 0; m < NUM_MODULES; ++m)
+    {
+        // Only the symbol table is read here; bodies are read on first use.
+        Expected<std::unique_ptr<Module>> moduleOrErr =
+            getOwningLazyBitcodeModule(std::move(moduleBuffers[m]), m_context);
+        if (!moduleOrErr)
+        {
+            consumeError(moduleOrErr.takeError());
+            return false;
+        }
+        m_modules[m] = std::move(*moduleOrErr);
+        // Named metadata is copied into every slice.
+        if (Error err = m_modules[m]->materializeMetadata())
+        {
+            consumeError(std::move(err));
+            return false;
+        }
+    }
+    m_loadMicroseconds = microsecondsSince(loadStart);
+
+    for (unsigned m = 0; m < NUM_MODULES; ++m)
+    {
+        for (Function& F : *m_modules[m])
+        {
+            if (F.isDeclaration())
+            {
+                continue;
+            }
+            auto inserted = m_index.insert(std::make_pair(F.getName(), (unsigned)m_functions.size()));
+            if (inserted.second)
+            {
+                m_functions.push_back(FunctionEntry{ &F, m, false, {} });
+            }
+        }
+    }
+
+    // Global variables are always imported as a whole, so built-ins that they
+    // point to are always needed.
+    for (unsigned m = 0; m < NUM_MODULES; ++m)
+    {
+        for (GlobalVariable& GV : m_modules[m]->globals())
+        {
+            if (GV.hasInitializer())
+            {
+                addReferencedFunctions(GV.getInitializer(), m_globalRefs);
+            }
+        }
+    }
+    return true;
+}
+
+void BiFSnapshot::addReferencedFunctions(const Value* root, std::vector<unsigned>& refs) const
+{
+    SmallVector<const Value*, 16> worklist;
+    SmallPtrSet<const Value*, 16> visited;
+    worklist.push_back(root);
+    while (!worklist.empty())
+    {
+        const Value* V = worklist.pop_back_val();
+        if (const Function* F = dyn_cast<Function>(V))
+        {
+            auto it = m_index.find(F->getName());
+            if (it != m_index.end())
+            {
+                refs.push_back(it->second);
+            }
+            continue;
+        }
+        // Global variables are always imported; only look through constants.
+        if (!isa<Constant>(V) || isa<GlobalValue>(V))
+        {
+            continue;
+        }
+        for (const Value* op : cast<Constant>(V)->operands())
+        {
+            if (visited.insert(op).second)
+            {
+                worklist.push_back(op);
+            }
+        }
+    }
+}
+
+void BiFSnapshot::computeRefs(unsigned id) const
+{
+    FunctionEntry& entry = m_functions[id];
+    if (entry.refsComputed)
+    {
+        return;
+    }
+    entry.refsComputed = true;
+
+    if (Error err = entry.function->materialize())
+    {
+        consumeError(std::move(err));
+        IGC_ASSERT_MESSAGE(0, "Failed to materialize built-in function");
+        return;
+    }
+
+    for (const Instruction& I : instructions(entry.function))
+    {
+        for (const Value* op : I.operands())
+        {
+            if (isa<Constant>(op))
+            {
+                addReferencedFunctions(op, entry.refs);
+            }
+        }
+    }
+    std::sort(entry.refs.begin(), entry.refs.end());
+    entry.refs.erase(std::unique(entry.refs.begin(), entry.refs.end()), entry.refs.end());
+}
+
+BiFSnapshot::Slice BiFSnapshot::extract(const std::vector<std::string>& names, LLVMContext& ctx) const
+{
+    const auto extractStart = std::chrono::steady_clock::now();
+    std::array<std::string, NUM_MODULES> bitcode;
+    bool hit = false;
+
+    std::vector<bool> inClosure(m_functions.size(), false);
+    std::vector<unsigned> closure;
+    {
+        std::lock_guard<std::mutex> lock(m_contextMutex);
+        std::vector<unsigned> worklist(m_globalRefs);
+        for (const std::string& name : names)
+        {
+            auto it = m_index.find(name);
+            if (it != m_index.end())
+            {
+                worklist.push_back(it->second);
+            }
+        }
+
+        while (!worklist.empty())
+        {
+            unsigned id = worklist.back();
+            worklist.pop_back();
+            if (inClosure[id])
+            {
+                continue;
+            }
+            inClosure[id] = true;
+            closure.push_back(id);
+            computeRefs(id);
+            worklist.insert(worklist.end(), m_functions[id].refs.begin(), m_functions[id].refs.end());
+        }
+    }
+    std::sort(closure.begin(), closure.end());
+
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        auto cached = m_sliceCache.find(closure);
+        if (cached != m_sliceCache.end())
+        {
+            bitcode = cached->second.bitcode;
+            cached->second.lastUse = ++m_useCounter;
+            hit = true;
+        }
+    }
+
+    if (!hit)
+    {
+        // The slices are cloned in the private context, which cannot be
+        // used by several threads at once. Cache lookups of other
+        // compilations do not wait for this.
+        std::lock_guard<std::mutex> lock(m_contextMutex);
+        for (unsigned m = 0; m < NUM_MODULES; ++m)
+        {
+            // Definitions outside of the closure become declarations,
+            // global variables are kept as BIImport links them all.
+            auto shouldClone = [&](const GlobalValue* GV)
+            {
+                const Function* F = dyn_cast<Function>(GV);
+                if (!F)
+                {
+                    return true;
+                }
+                auto it = m_index.find(F->getName());
+                return it != m_index.end() && inClosure[it->second] &&
+                    m_functions[it->second].module == m;
+            };
+            ValueToValueMapTy VMap;
+            std::unique_ptr<Module> slice = CloneModule(*m_modules[m], VMap, shouldClone);
+            // Drop the declarations of the built-ins outside of the closure,
+            // so that the slice does not carry the whole symbol table.
+            for (auto FI = slice->begin(), FE = slice->end(); FI != FE;)
+            {
+                Function& F = *FI++;
+                if (F.isDeclaration() && F.use_empty())
+                {
+                    F.eraseFromParent();
+                }
+            }
+            raw_string_ostream OS(bitcode[m]);
+            IGCLLVM::WriteBitcodeToFile(slice.get(), OS);
+            OS.flush();
+        }
+    }
+
+    if (!hit)
+    {
+        const uint64_t budget = (uint64_t)IGC_GET_FLAG_VALUE(BiFSnapshotCacheSizeKB) * 1024;
+        const uint64_t sliceBytes = bitcode[GENERIC_MODULE].size() + bitcode[SIZET_MODULE].size();
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        // Another compilation may have added the same closure meanwhile.
+        if (sliceBytes <= budget && m_sliceCache.find(closure) == m_sliceCache.end())
+        {
+            evictSlices(budget - sliceBytes);
+            m_sliceCache.emplace(std::move(closure), CachedSlice{ bitcode, ++m_useCounter });
+            m_sliceCacheBytes += sliceBytes;
+            s_stats.cacheBytes = m_sliceCacheBytes;
+        }
+    }
+
+    Slice slice;
+    std::unique_ptr<Module>* modules[NUM_MODULES] = { &slice.generic, &slice.sizeT };
+    for (unsigned m = 0; m < NUM_MODULES; ++m)
+    {
+        Expected<std::unique_ptr<Module>> moduleOrErr = getOwningLazyBitcodeModule(
+            MemoryBuffer::getMemBufferCopy(bitcode[m], m_modules[m]->getModuleIdentifier()), ctx);
+        if (!moduleOrErr)
+        {
+            consumeError(moduleOrErr.takeError());
+            IGC_ASSERT_MESSAGE(0, "Error loading built-in module slice");
+            return Slice();
+        }
+        *modules[m] = std::move(*moduleOrErr);
+    }
+    // Same as when the full modules are loaded.
+    slice.generic->setTargetTriple(slice.sizeT->getTargetTriple());
+
+    const uint64_t sliceBytes = bitcode[GENERIC_MODULE].size() + bitcode[SIZET_MODULE].size();
+    const uint64_t extractMicroseconds = microsecondsSince(extractStart);
+    (hit ? s_stats.sliceHits : s_stats.sliceMisses)++;
+    if (m_bitcodeBytes > sliceBytes)
+    {
+        s_stats.bytesSaved += m_bitcodeBytes - sliceBytes;
+    }
+    if (m_loadMicroseconds > extractMicroseconds)
+    {
+        s_stats.microsecondsSaved += m_loadMicroseconds - extractMicroseconds;
+    }
+    printStats(hit ? "hit" : "miss", sliceBytes);
+    return slice;
+}
+
+void BiFSnapshot::evictSlices(uint64_t budget) const
+{
+    while (m_sliceCacheBytes > budget && !m_sliceCache.empty())
+    {
+        auto oldest = m_sliceCache.begin();
+        for (auto it = m_sliceCache.begin(), e = m_sliceCache.end(); it != e; ++it)
+        {
+            if (it->second.lastUse < oldest->second.lastUse)
+            {
+                oldest = it;
+            }
+        }
+        m_sliceCacheBytes -= oldest->second.bitcode[GENERIC_MODULE].size() +
+            oldest->second.bitcode[SIZET_MODULE].size();
+        m_sliceCache.erase(oldest);
+        s_stats.sliceEvictions++;
+    }
+}
+
+void BiFSnapshot::printStats(const char* event, uint64_t sliceBytes) const
+{
+    if (IGC_IS_FLAG_DISABLED(BiFSnapshotVerbose))
+    {
+        return;
+    }
+    fprintf(stderr, "IGC BiF snapshot %s: slice %llu B (hits %u, misses %u, evictions %u, cached %llu B, saved %llu B, %llu ms)\n",
+        event, (unsigned long long)sliceBytes,
+        s_stats.sliceHits.load(), s_stats.sliceMisses.load(), s_stats.sliceEvictions.load(),
+        (unsigned long long)s_stats.cacheBytes.load(),
+        (unsigned long long)s_stats.bytesSaved.load(),
+        (unsigned long long)(s_stats.microsecondsSaved.load() / 1000));
+}
@@ -0,0 +1,134 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "common/LLVMWarningsPush.hpp"
+#include <llvm/ADT/StringMap.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include "common/LLVMWarningsPop.hpp"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace IGC
+{
+    /// Process-wide, read-only index of the generic and size_t built-in
+    /// modules.
+    ///
+    /// The built-in bitcode is lazily parsed once per process into a private
+    /// LLVMContext. For each compilation only the built-ins reachable from the
+    /// requested names are cloned into small modules, which are then lazily
+    /// loaded into the caller's context. BIImport handles these slices exactly
+    /// like the full modules, without re-reading the whole symbol table of the
+    /// built-in library for every program.
+    ///
+    /// Snapshots are shared by all translation blocks of the process. The
+    /// built-in resources do not depend on the platform, so one snapshot per
+    /// pointer size is kept. The bitcode of recently requested slices is
+    /// cached within the BiFSnapshotCacheSizeKB budget.
+    class BiFSnapshot
+    {
+    public:
+        struct Stats
+        {
+            std::atomic<uint32_t> snapshots{ 0 };
+            std::atomic<uint32_t> sliceHits{ 0 };
+            std::atomic<uint32_t> sliceMisses{ 0 };
+            std::atomic<uint32_t> sliceEvictions{ 0 };
+            std::atomic<uint64_t> cacheBytes{ 0 };
+            // Built-in bitcode that did not have to be read for a compilation.
+            std::atomic<uint64_t> bytesSaved{ 0 };
+            // Time to load the full built-in modules minus the time spent on
+            // extracting the slices, summed over all compilations.
+            std::atomic<uint64_t> microsecondsSaved{ 0 };
+        };
+
+        struct Buffers
+        {
+            std::unique_ptr<llvm::MemoryBuffer> generic;
+            std::unique_ptr<llvm::MemoryBuffer> sizeT;
+        };
+
+        struct Slice
+        {
+            std::unique_ptr<llvm::Module> generic;
+            std::unique_ptr<llvm::Module> sizeT;
+        };
+
+        /// @brief  Returns the snapshot for the given pointer size, created from
+        ///         the buffers returned by load on first use. Returns nullptr if
+        ///         the built-in modules could not be parsed.
+        static const BiFSnapshot* get(unsigned pointerSizeInBits, const std::function<Buffers()>& load);
+
+        /// @brief  Creates lazily loadable modules in ctx holding the definitions
+        ///         of names and of every built-in they reference. Names that are
+        ///         not built-ins are ignored.
+        Slice extract(const std::vector<std::string>& names, llvm::LLVMContext& ctx) const;
+
+        static const Stats& getStats() { return s_stats; }
+
+    private:
+        enum { GENERIC_MODULE = 0, SIZET_MODULE = 1, NUM_MODULES = 2 };
+
+        struct CachedSlice
+        {
+            std::array<std::string, NUM_MODULES> bitcode;
+            uint64_t lastUse;
+        };
+
+        struct FunctionEntry
+        {
+            llvm::Function* function;
+            unsigned module;
+            bool refsComputed;
+            std::vector<unsigned> refs;
+        };
+
+        BiFSnapshot() = default;
+        bool init(Buffers buffers);
+        /// Materializes entry id and collects the built-ins it references.
+        void computeRefs(unsigned id) const;
+        void addReferencedFunctions(const llvm::Value* root, std::vector<unsigned>& refs) const;
+        /// Drops the least recently used slices until the cache fits the budget.
+        void evictSlices(uint64_t budget) const;
+        void printStats(const char* event, uint64_t sliceBytes) const;
+
+        // Guards the private context and lazy materialization.
+        mutable std::mutex m_contextMutex;
+        // Guards the slice cache.
+        mutable std::mutex m_cacheMutex;
+        // Declared before the modules so that it outlives them.
+        llvm::LLVMContext m_context;
+        std::array<std::unique_ptr<llvm::Module>, NUM_MODULES> m_modules;
+        mutable std::vector<FunctionEntry> m_functions;
+        // Name of a defined built-in -> index into m_functions. Generic
+        // definitions take precedence, as in BIImport::GetBuiltinFunction2.
+        llvm::StringMap<unsigned> m_index;
+        // Built-ins referenced from global variable initializers.
+        std::vector<unsigned> m_globalRefs;
+        // Size of the built-in bitcode and time it takes to load it lazily,
+        // i.e. what each compilation pays without the snapshot.
+        uint64_t m_bitcodeBytes = 0;
+        uint64_t m_loadMicroseconds = 0;
+        // Bitcode of the slices of recently requested closures.
+        mutable std::map<std::vector<unsigned>, CachedSlice> m_sliceCache;
+        mutable uint64_t m_sliceCacheBytes = 0;
+        mutable uint64_t m_useCounter = 0;
+
+        static Stats s_stats;
+    };
+} // namespace IGC
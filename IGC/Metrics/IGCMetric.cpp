@@ -174,6 +174,11 @@ namespace IGCMetrics
         get(igcMetric)->CollectNonUniformLoop(pFunc, LoopCount, problematicLoop);
     }
 
+    void IGCMetric::CollectCompileBudget(unsigned BudgetMs, unsigned CompileTimeMs, const std::vector<std::string>& Degradations)
+    {
+        get(igcMetric)->CollectCompileBudget(BudgetMs, CompileTimeMs, Degradations);
+    }
+
     void IGCMetric::FinalizeStats()
     {
         get(igcMetric)->FinalizeStats();
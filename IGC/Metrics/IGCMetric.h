@@ -17,6 +17,8 @@ SPDX-License-Identifier: MIT
 #include <3d/common/iStdLib/types.h>
 #include <common/shaderHash.hpp>
 #include "KernelInfo.h"
+#include <string>
+#include <vector>
 
 #pragma once
 
@@ -97,6 +99,8 @@ namespace IGCMetrics
 
         void CollectNonUniformLoop(llvm::Function* pFunc, short LoopCount, llvm::Loop* problematicLoop);
 
+        void CollectCompileBudget(unsigned BudgetMs, unsigned CompileTimeMs, const std::vector<std::string>& Degradations);
+
         void CollectDataFromDebugInfo(IGC::DebugInfoData* pDebugInfo, IGC::DbgDecoder* pDebugDecoder);
 
         void FinalizeStats();
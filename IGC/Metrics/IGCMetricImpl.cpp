@@ -406,6 +406,22 @@ namespace IGCMetrics
 #endif
     }
 
+    void IGCMetricImpl::CollectCompileBudget(
+        unsigned BudgetMs,
+        unsigned CompileTimeMs,
+        const std::vector<std::string>& Degradations)
+    {
+        if (!Enable()) return;
+#ifdef IGC_METRICS__PROTOBUF_ATTACHED
+        oclProgram.set_compilebudgetms(BudgetMs);
+        oclProgram.set_compiletimems(CompileTimeMs);
+        for (const auto& degradation : Degradations)
+        {
+            oclProgram.add_budgetdegradations(degradation);
+        }
+#endif
+    }
+
     void IGCMetricImpl::FinalizeStats()
     {
         if (!Enable()) return;
@@ -159,6 +159,11 @@ namespace IGCMetrics
             llvm::Function* pFunc,
             short LoopCount, llvm::Loop* problematicLoop);
 
+        void CollectCompileBudget(
+            unsigned BudgetMs,
+            unsigned CompileTimeMs,
+            const std::vector<std::string>& Degradations);
+
         void FinalizeStats();
 
         void OutputMetrics();
@@ -256,6 +256,8 @@ static void adjustTransformationsAndOptimizations(vc::CompileOptions &Opts) {
 
   if (unsigned LoopUnrollThreshold = IGC_GET_FLAG_VALUE(VCLoopUnrollThreshold))
     Opts.ForceLoopUnrollThreshold = LoopUnrollThreshold;
+  if (unsigned FinalizerThreads = IGC_GET_FLAG_VALUE(VCFinalizerThreads))
+    Opts.FinalizerThreads = FinalizerThreads;
 
   Opts.NoOptFinalizerMode =
       deriveDefaultableFlagValue<vc::NoOptFinalizerControl>(
@@ -142,6 +142,7 @@ struct CompileOptions {
   bool DirectCallsOnly = false;
   DebugInfoStripControl StripDebugInfoCtrl = DebugInfoStripControl::None;
   unsigned ForceLoopUnrollThreshold = 0;
+  unsigned FinalizerThreads = 0;
 };
 
 struct ExternalData {
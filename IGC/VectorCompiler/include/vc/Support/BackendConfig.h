@@ -150,6 +150,10 @@ struct GenXBackendOptions {
   // Loop unroll threshold. Value 0 means to keep default threshold.
   unsigned LoopUnrollThreshold = 0;
 
+  // Number of threads the finalizer may use to compile independent kernels
+  // of the module. Values 0 and 1 mean sequential compilation.
+  unsigned FinalizerThreads = 0;
+
   // Calling enforceLLVMOptions queries the state of LLVM options and
   // updates BackendOptions accordingly.
   // Note: current implementation allows backend options to be configured by
@@ -323,6 +327,8 @@ public:
   unsigned getLoopUnrollThreshold() const {
     return Options.LoopUnrollThreshold;
   }
+
+  unsigned getFinalizerThreads() const { return Options.FinalizerThreads; }
 };
 } // namespace llvm
 
@@ -243,6 +243,7 @@ static GenXBackendOptions createBackendOptions(const vc::CompileOptions &Opts) {
   if (Opts.HasGPUFenceScopeOnSingleTileGPUs)
     BackendOpts.GPUFenceScopeOnSingleTileGPUs = true;
   BackendOpts.LoopUnrollThreshold = Opts.ForceLoopUnrollThreshold;
+  BackendOpts.FinalizerThreads = Opts.FinalizerThreads;
 
   BackendOpts.DisableLiveRangesCoalescing =
       getDefaultOverridableFlag(Opts.DisableLRCoalescingMode, false);
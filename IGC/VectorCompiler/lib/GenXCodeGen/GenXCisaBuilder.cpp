@@ -6640,6 +6640,13 @@ collectFinalizerArgs(StringSaver &Saver, const GenXSubtarget &ST,
   }
   if (ST.hasFusedEU())
     addArgument("-fusedCallWA");
+  // Every function group is a separate vISA kernel, so kernels without
+  // subroutines can be finalized concurrently. The output is the same as
+  // with sequential compilation.
+  if (BC.getFinalizerThreads() > 1) {
+    addArgument("-numCompileThreads");
+    addArgument(std::to_string(BC.getFinalizerThreads()));
+  }
   return Argv;
 }
 
@@ -35,6 +35,7 @@ SPDX-License-Identifier: MIT
 #include "llvmWrapper/IR/InstrTypes.h"
 #include "llvmWrapper/IR/Instructions.h"
 
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/IR/BasicBlock.h"
@@ -79,14 +80,14 @@ bool GenXLiveness::runOnFunctionGroup(FunctionGroup &ArgFG)
  */
 void GenXLiveness::releaseMemory() {
   LLVM_DEBUG(dbgs() << "releaseMemory for GenXLivness\n");
-  while (!LiveRangeMap.empty()) {
-    LiveRange *LR = begin()->second;
-    for (auto i = LR->value_begin(), e = LR->value_end(); i != e; ++i) {
-      SimpleValue V = *i;
-      LiveRangeMap.erase(V);
-    }
+  // Several values share a live range. Collect each one once rather than
+  // erasing its values, since DenseMap::begin() scans past the erased buckets.
+  SmallPtrSet<LiveRange *, 32> LRs;
+  for (auto &Entry : LiveRangeMap)
+    LRs.insert(Entry.second);
+  for (LiveRange *LR : LRs)
     delete LR;
-  }
+  LiveRangeMap.clear();
   FG = 0;
   CG.reset();
   for (auto i = UnifiedRets.begin(), e = UnifiedRets.end(); i != e; ++i)
@@ -847,8 +848,9 @@ void GenXLiveness::moveUnifiedRet(Function *OldF, Function *NewF)
   if (i == UnifiedRets.end())
     return;
   Value *UR = i->second;
-  UnifiedRets[NewF] = UR;
+  // Inserting may invalidate i.
   UnifiedRets.erase(i);
+  UnifiedRets[NewF] = UR;
   UnifiedRetToFunc[UR] = NewF;
 }
 
@@ -165,6 +165,7 @@ SPDX-License-Identifier: MIT
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Value.h"
 #include "llvm/IR/ValueHandle.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/MapVector.h"
 #include <map>
@@ -475,17 +476,37 @@ public:
 
 } // end namespace genx
 
+// Specialize DenseMapInfo for SimpleValue.
+template <> struct DenseMapInfo<genx::SimpleValue> {
+  static inline genx::SimpleValue getEmptyKey() {
+    return genx::SimpleValue(DenseMapInfo<Value *>::getEmptyKey());
+  }
+  static inline genx::SimpleValue getTombstoneKey() {
+    return genx::SimpleValue(DenseMapInfo<Value *>::getTombstoneKey());
+  }
+  static unsigned getHashValue(const genx::SimpleValue &SV) {
+    return DenseMapInfo<Value *>::getHashValue(SV.getValue()) ^
+           DenseMapInfo<unsigned>::getHashValue(SV.getIndex());
+  }
+  static bool isEqual(const genx::SimpleValue &LHS,
+                      const genx::SimpleValue &RHS) {
+    return LHS == RHS;
+  }
+};
+
 class GenXLiveness : public FGPassImplInterface, public IDMixin<GenXLiveness> {
   FunctionGroup *FG = nullptr;
-  using LiveRangeMap_t = std::map<genx::SimpleValue, genx::LiveRange *>;
+  // Hashed rather than ordered: coalescing and the passes after it look up
+  // live ranges for every operand they visit.
+  using LiveRangeMap_t = DenseMap<genx::SimpleValue, genx::LiveRange *>;
   LiveRangeMap_t LiveRangeMap;
   std::unique_ptr<genx::CallGraph> CG;
   GenXBaling *Baling = nullptr;
   GenXNumbering *Numbering = nullptr;
   const GenXSubtarget *Subtarget = nullptr;
   const DataLayout *DL = nullptr;
-  std::map<Function *, Value *> UnifiedRets;
-  std::map<Value *, Function *> UnifiedRetToFunc;
+  DenseMap<Function *, Value *> UnifiedRets;
+  DenseMap<Value *, Function *> UnifiedRetToFunc;
   std::map<AssertingVH<Value>, Value *> ArgAddressBaseMap;
   // Flipped ArgAddressBaseMap. Mulpimap is chosen because the same base may be
   // used for different convert.addr instructions.
@@ -510,6 +531,8 @@ public:
   // value, and you only get each value once. The ->second field is the
   // LiveRange pointer, and you may get each one multiple times because
   // a live range may contain multiple values.
+  // The order is unspecified and iterators are invalidated by any change to
+  // the live ranges.
   typedef LiveRangeMap_t::iterator iterator;
   typedef LiveRangeMap_t::const_iterator const_iterator;
   iterator begin() { return LiveRangeMap.begin(); }
@@ -626,24 +649,6 @@ using GenXLivenessWrapper = FunctionGroupWrapperPass<GenXLiveness>;
 
 void initializeGenXLivenessWrapperPass(PassRegistry &);
 
-// Specialize DenseMapInfo for SimpleValue.
-template <> struct DenseMapInfo<genx::SimpleValue> {
-  static inline genx::SimpleValue getEmptyKey() {
-    return genx::SimpleValue(DenseMapInfo<Value *>::getEmptyKey());
-  }
-  static inline genx::SimpleValue getTombstoneKey() {
-    return genx::SimpleValue(DenseMapInfo<Value *>::getTombstoneKey());
-  }
-  static unsigned getHashValue(const genx::SimpleValue &SV) {
-    return DenseMapInfo<Value *>::getHashValue(SV.getValue()) ^
-           DenseMapInfo<unsigned>::getHashValue(SV.getIndex());
-  }
-  static bool isEqual(const genx::SimpleValue &LHS,
-                      const genx::SimpleValue &RHS) {
-    return LHS == RHS;
-  }
-};
-
 } // end namespace llvm
 namespace std {
 template <> struct hash<llvm::genx::Segment> {
@@ -136,6 +136,10 @@ static cl::opt<unsigned> VCLoopUnrollThreshold(
     "vc-loop-unroll-threshold", cl::Hidden,
     cl::desc("Threshold value for LLVM loop unroll pass"));
 
+static cl::opt<unsigned> FinalizerThreadsOpt(
+    "vc-finalizer-threads", cl::Hidden,
+    cl::desc("Number of threads finalizing independent kernels"));
+
 //===----------------------------------------------------------------------===//
 //
 // Backend config related stuff.
@@ -177,6 +181,7 @@ void GenXBackendOptions::enforceLLVMOptions() {
   enforceOptionIfSpecified(EnablePreemption, EnablePreemptionOpt);
   enforceOptionIfSpecified(DirectCallsOnly, DirectCallsOnlyOpt);
   enforceOptionIfSpecified(LoopUnrollThreshold, VCLoopUnrollThreshold);
+  enforceOptionIfSpecified(FinalizerThreads, FinalizerThreadsOpt);
 }
 
 static std::unique_ptr<MemoryBuffer>
@@ -82,6 +82,8 @@ namespace IGC
                                   - compilerStats.GetF64("TimeVISACompile", 8), simdsize);
                 }
                 compilerStats.SetI64("numGRFSpillFill", jitInfo->numGRFSpillFill, simdsize);
+                compilerStats.SetI64("numScratchBytesMoved", jitInfo->numScratchBytesMoved, simdsize);
+                compilerStats.SetI64("numScratchBytesMovedBeforeCleanup", jitInfo->numScratchBytesMovedBeforeCleanup, simdsize);
                 compilerStats.SetI64("numFlagSpillFill", jitInfo->numFlagSpillStore + jitInfo->numFlagSpillLoad, simdsize);
                 compilerStats.SetI64("numInst", jitInfo->numAsmCount, simdsize);
             }
@@ -628,8 +628,21 @@ void IGCPassManager::add(Pass *P)
         PassManager::add(createTimeStatsIGCPass(m_pContext, m_name + '_' + std::string(P->getPassName()), STATS_COUNTER_START));
     }
 
+    // Like the per-pass timers above, the markers are module passes and
+    // split function pass pipelines, so they are only added when tracing.
+    const bool tracePass = TraceEvents::isEnabled();
+    if (tracePass)
+    {
+        PassManager::add(createTraceEventPass(m_pContext, m_name + '_' + std::string(P->getPassName()), STATS_COUNTER_START));
+    }
+
     PassManager::add(P);
 
+    if (tracePass)
+    {
+        PassManager::add(createTraceEventPass(m_pContext, m_name + '_' + std::string(P->getPassName()), STATS_COUNTER_END));
+    }
+
     if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS))
     {
         PassManager::add(createTimeStatsIGCPass(m_pContext, m_name + '_' + std::string(P->getPassName()), STATS_COUNTER_END));
@@ -9,6 +9,7 @@ SPDX-License-Identifier: MIT
 #include "common/Stats.hpp"
 #include "Compiler/CodeGenPublic.h"
 #include "common/debug/Dump.hpp"
+#include "common/igc_regkeys.hpp"
 
 #include <iStdLib/File.h>
 #include <iStdLib/Timestamp.h>
@@ -22,6 +23,7 @@ SPDX-License-Identifier: MIT
 #include "common/secure_string.h"
 #include <fstream>
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
@@ -34,7 +36,16 @@ extern "C" double getTimerCounts(unsigned int idx);
 extern "C" void getTimerNames(char* timerName, unsigned int idx);
 extern "C" unsigned int getTimerHits(unsigned int idx);
 extern "C" unsigned int getTotalTimers();
+extern "C" unsigned int getTotalPassStats();
+extern "C" const char* getPassStatName(unsigned int idx);
+extern "C" int64_t getPassStatTicks(unsigned int idx);
+extern "C" int64_t getPassStatArenaBytes(unsigned int idx);
+extern "C" int64_t getPassStatInstDelta(unsigned int idx);
+extern "C" unsigned int getPassStatHits(unsigned int idx);
 #endif
+extern "C" void enableTraceEvents(const char* fileName);
+extern "C" void traceEventBegin(const char* name, const char* category);
+extern "C" void traceEventEnd(const char* name, const char* category);
 
 namespace {
     static const unsigned g_cIndentSZ = 4; //<! number of spaces to indent by
@@ -433,6 +444,39 @@ const char* g_cCompTimeIntervals[MAX_COMPILE_TIME_INTERVALS+1] =
 #undef DEFINE_TIME_STAT
 };
 
+bool IGC::TraceEvents::isEnabled()
+{
+    // Regkeys are loaded before anything is compiled, so the key only has
+    // to be looked at on first use.
+    static const bool enabled = []()
+    {
+        const char* fileName = IGC_GET_REGKEYSTRING(TraceEventsFile);
+        if (fileName == nullptr || fileName[0] == '\0')
+        {
+            return false;
+        }
+        enableTraceEvents(fileName);
+        return true;
+    }();
+    return enabled;
+}
+
+void IGC::TraceEvents::begin(const char* name, const char* category)
+{
+    if (isEnabled())
+    {
+        traceEventBegin(name, category);
+    }
+}
+
+void IGC::TraceEvents::end(const char* name, const char* category)
+{
+    if (isEnabled())
+    {
+        traceEventEnd(name, category);
+    }
+}
+
 std::string str(COMPILE_TIME_INTERVALS cti)
 {
     switch (cti)
@@ -546,20 +590,84 @@ TimeStats::TimeStats()
     m_freq = iSTD::GetTimestampFrequency();
 
     m_PassTimeStatsMap.clear();
+    m_VISAPassTimeStatsMap.clear();
 }
 
 TimeStats::~TimeStats()
 {
     m_PassTimeStatsMap.clear();
+    m_VISAPassTimeStatsMap.clear();
 }
 
-void TimeStats::recordVISATimers()
+VISATimerReadings VISATimerReadings::read()
 {
+    VISATimerReadings readings;
     // getTotalTimers() +1 because there is a unaccounted counter
     for (unsigned int i = 0; i < getTotalTimers(); ++i)
     {
-        m_elapsedTime[TIME_VISA_TOTAL+i] += getTimerTicks(i);
-        m_hitCount[TIME_VISA_TOTAL + i] = getTimerHits(i);
+        readings.timers.push_back({getTimerTicks(i), getTimerHits(i)});
+    }
+    if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS))
+    {
+        for (unsigned int i = 0; i < getTotalPassStats(); ++i)
+        {
+            readings.passes.push_back({getPassStatName(i), getPassStatTicks(i),
+                getPassStatArenaBytes(i), getPassStatInstDelta(i), getPassStatHits(i)});
+        }
+    }
+    return readings;
+}
+
+void VISATimerReadings::add(const VISATimerReadings& other)
+{
+    if (timers.size() < other.timers.size())
+    {
+        timers.resize(other.timers.size(), {0, 0});
+    }
+    for (size_t i = 0; i < other.timers.size(); ++i)
+    {
+        timers[i].ticks += other.timers[i].ticks;
+        timers[i].hits += other.timers[i].hits;
+    }
+    for (const Pass& pass : other.passes)
+    {
+        auto it = std::find_if(passes.begin(), passes.end(), [&](const Pass& p) {
+            return strcmp(p.name, pass.name) == 0;
+        });
+        if (it == passes.end())
+        {
+            passes.push_back(pass);
+            continue;
+        }
+        it->ticks += pass.ticks;
+        it->arenaBytes += pass.arenaBytes;
+        it->instDelta += pass.instDelta;
+        it->hits += pass.hits;
+    }
+}
+
+void TimeStats::recordVISATimers()
+{
+    recordVISATimers(VISATimerReadings::read());
+}
+
+void TimeStats::recordVISATimers(const VISATimerReadings& readings)
+{
+    for (unsigned int i = 0; i < readings.timers.size(); ++i)
+    {
+        m_elapsedTime[TIME_VISA_TOTAL+i] += readings.timers[i].ticks;
+        m_hitCount[TIME_VISA_TOTAL + i] = readings.timers[i].hits;
+    }
+
+    // vISA optimizer passes run within EmitPass, so they are kept apart
+    // from the IGC/LLVM passes and not added to m_PassTotalTicks
+    for (const VISATimerReadings::Pass& pass : readings.passes)
+    {
+        PerPassTimeStat& stat = m_VISAPassTimeStatsMap[pass.name];
+        stat.PassElapsedTime += (uint64_t)pass.ticks;
+        stat.PassHitCount += pass.hits;
+        stat.PassArenaBytes += pass.arenaBytes;
+        stat.PassInstCountDelta += pass.instDelta;
     }
 }
 
@@ -578,6 +686,14 @@ void TimeStats::recordTimerEnd( COMPILE_TIME_INTERVALS compileInterval )
     m_hitCount[ compileInterval ]++;
 }
 
+void TimeStats::recordTimerEnd( COMPILE_TIME_INTERVALS compileInterval, uint64_t startTick )
+{
+    IGC_ASSERT(0 <= compileInterval);
+    IGC_ASSERT(compileInterval < MAX_COMPILE_TIME_INTERVALS);
+    m_elapsedTime[ compileInterval ] += iSTD::GetTimestampCounter() - startTick;
+    m_hitCount[ compileInterval ]++;
+}
+
 uint64_t TimeStats::getCompileTime( COMPILE_TIME_INTERVALS compileInterval ) const
 {
     IGC_ASSERT(0 <= compileInterval);
@@ -592,6 +708,43 @@ uint64_t TimeStats::getCompileHit( COMPILE_TIME_INTERVALS compileInterval ) cons
     return m_hitCount[ compileInterval ];
 }
 
+namespace {
+    void addPassTimeStats(std::map<std::string, PerPassTimeStat>& to, const std::map<std::string, PerPassTimeStat>& from)
+    {
+        if (to.empty())
+        {
+            to.insert(from.begin(), from.end());
+            return;
+        }
+
+        std::map<std::string, PerPassTimeStat>::const_iterator fromIter;
+        std::map<std::string, PerPassTimeStat>::iterator toIter;
+
+        for (fromIter = from.begin(); fromIter != from.end(); fromIter++)
+        {
+            toIter = to.find(fromIter->first);
+            if (toIter != to.end())
+            {
+                // If the pass is already included in the combined list, add the numbers
+                toIter->second.PassHitCount += fromIter->second.PassHitCount;
+                toIter->second.PassElapsedTime += fromIter->second.PassElapsedTime;
+                toIter->second.PassArenaBytes += fromIter->second.PassArenaBytes;
+                toIter->second.PassInstCountDelta += fromIter->second.PassInstCountDelta;
+            }
+            else
+            {
+                // Add new pass from this run to the combined list
+                PerPassTimeStat stat;
+                stat.PassElapsedTime = fromIter->second.PassElapsedTime;
+                stat.PassHitCount = fromIter->second.PassHitCount;
+                stat.PassArenaBytes = fromIter->second.PassArenaBytes;
+                stat.PassInstCountDelta = fromIter->second.PassInstCountDelta;
+                to.insert(std::pair<std::string, PerPassTimeStat>(fromIter->first, stat));
+            }
+        }
+    }
+}
+
 void TimeStats::sumWith( const TimeStats* pOther )
 {
     // Add pOther's compile time's to us
@@ -607,34 +760,8 @@ void TimeStats::sumWith( const TimeStats* pOther )
 
     if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS))
     {
-        if (m_PassTimeStatsMap.empty())
-        {
-            m_PassTimeStatsMap.insert(pOther->m_PassTimeStatsMap.begin(), pOther->m_PassTimeStatsMap.end());
-        }
-        else
-        {
-            std::map<std::string, PerPassTimeStat>::const_iterator fromIter;
-            std::map<std::string, PerPassTimeStat>::iterator toIter;
-
-            for (fromIter = pOther->m_PassTimeStatsMap.begin(); fromIter != pOther->m_PassTimeStatsMap.end(); fromIter++)
-            {
-                toIter = m_PassTimeStatsMap.find(fromIter->first);
-                if (toIter != m_PassTimeStatsMap.end())
-                {
-                    // If the pass is already included in the combined list, add the numbers
-                    toIter->second.PassHitCount += fromIter->second.PassHitCount;
-                    toIter->second.PassElapsedTime += fromIter->second.PassElapsedTime;
-                }
-                else
-                {
-                    // Add new pass from this run to the combined list
-                    PerPassTimeStat stat;
-                    stat.PassElapsedTime = fromIter->second.PassElapsedTime;
-                    stat.PassHitCount = fromIter->second.PassHitCount;
-                    m_PassTimeStatsMap.insert(std::pair<std::string, PerPassTimeStat>(fromIter->first, stat));
-                }
-            }
-        }
+        addPassTimeStats(m_PassTimeStatsMap, pOther->m_PassTimeStatsMap);
+        addPassTimeStats(m_VISAPassTimeStatsMap, pOther->m_VISAPassTimeStatsMap);
     }
 }
 
@@ -1011,33 +1138,50 @@ void TimeStats::printPerPassSumTime(llvm::raw_ostream& OS) const
     const unsigned ticksCol = 50;                     //<! Location of the first character of the ticks column
     const unsigned percCol = ticksCol + colWidth + 2; //<! Location of the first character of the percent column
     const unsigned hitCol = percCol + colWidth + 2;   //<! Location of the first character of the hit column
+    const unsigned memCol = hitCol + colWidth + 2;    //<! Location of the first character of the arena KB column
+    const unsigned instCol = memCol + colWidth + 2;   //<! Location of the first character of the instruction delta column
 
     // table header
     FS.PadToColumn(ticksCol) << "ticks";
     FS.PadToColumn(percCol)  << "percent";
     FS.PadToColumn(hitCol)   << "hits";
+    FS.PadToColumn(memCol)   << "arena KB";
+    FS.PadToColumn(instCol)  << "inst delta";
     FS << "\n";
     const std::string bar(colWidth + 1, '-');
     FS.PadToColumn(ticksCol) << bar;
     FS.PadToColumn(percCol) << bar;
     FS.PadToColumn(hitCol) << bar;
+    FS.PadToColumn(memCol) << bar;
+    FS.PadToColumn(instCol) << bar;
     FS << "\n";
 
-    PerPassTimeStat stat;
-    uint64_t ticks = 0;
-    std::map<std::string, PerPassTimeStat>::const_iterator iter;
-
-    for (iter = m_PassTimeStatsMap.begin(); iter != m_PassTimeStatsMap.end(); iter++)
+    auto printPasses = [&](const std::map<std::string, PerPassTimeStat>& passes, unsigned nameCol)
     {
-        stat = iter->second;
-        ticks = stat.PassElapsedTime;
+        for (auto iter = passes.begin(); iter != passes.end(); iter++)
+        {
+            const PerPassTimeStat& stat = iter->second;
+            uint64_t ticks = stat.PassElapsedTime;
+
+            // pass ticks % hit
+            FS.PadToColumn(nameCol) << iter->first.substr(0, ticksCol - nameCol - 1);
+            FS.PadToColumn(ticksCol) << str(ticks, colWidth);
+            FS.PadToColumn(percCol) << str(ticks / (double)m_PassTotalTicks * 100.0, colWidth, 2);
+            FS.PadToColumn(percCol) << str(stat.PassHitCount, colWidth);
+            FS.PadToColumn(memCol) << str(stat.PassArenaBytes / 1024.0, colWidth, 1);
+            FS.PadToColumn(instCol) << str((double)stat.PassInstCountDelta, colWidth, 0);
+            FS << "\n";
+        }
+    };
 
-        // pass ticks % hit
-        FS.PadToColumn(startCol) << iter->first.substr(0, ticksCol - startCol - 1);
-        FS.PadToColumn(ticksCol) << str(ticks, colWidth);
-        FS.PadToColumn(percCol) << str(ticks / (double)m_PassTotalTicks * 100.0, colWidth, 2);
-        FS.PadToColumn(percCol) << str(stat.PassHitCount, colWidth);
+    printPasses(m_PassTimeStatsMap, startCol);
+
+    // the vISA optimizer passes are part of the EmitPass ticks above
+    if (!m_VISAPassTimeStatsMap.empty())
+    {
         FS << "\n";
+        FS.PadToColumn(startCol) << "vISA passes (within EmitPass):\n";
+        printPasses(m_VISAPassTimeStatsMap, startCol + 2);
     }
 
     FS << "\n";
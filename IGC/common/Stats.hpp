@@ -28,6 +28,7 @@ SPDX-License-Identifier: MIT
 
 #include <string>
 #include <map>
+#include <vector>
 
 namespace llvm
 {
@@ -198,6 +199,49 @@ bool isDashboardTimer( COMPILE_TIME_INTERVALS cti );
 COMPILE_TIME_INTERVALS parentInterval( COMPILE_TIME_INTERVALS cti );
 int parentIntervalDepth( COMPILE_TIME_INTERVALS cti );
 
+// *******************************************************//
+//                      TRACE EVENTS
+// *******************************************************//
+// Timeline of IGC intervals, LLVM passes, kernel/SIMD variants and vISA
+// phases written in Chrome trace event format to the file named by the
+// TraceEventsFile regkey (available in release builds, e.g. through the
+// IGC_TraceEventsFile environment variable). Recording is done by the vISA
+// timer library so both share one timeline.
+namespace IGC
+{
+namespace TraceEvents
+{
+    bool isEnabled();
+    void begin(const char* name, const char* category);
+    void end(const char* name, const char* category);
+
+    // Records a begin/end pair around its lifetime if tracing is enabled.
+    class Scope
+    {
+    public:
+        Scope(std::string name, const char* category)
+        {
+            if (isEnabled())
+            {
+                m_name = std::move(name);
+                m_category = category;
+                begin(m_name.c_str(), m_category);
+            }
+        }
+        ~Scope()
+        {
+            if (m_category)
+            {
+                end(m_name.c_str(), m_category);
+            }
+        }
+    private:
+        std::string m_name;
+        const char* m_category = nullptr;
+    };
+} // namespace TraceEvents
+} // namespace IGC
+
 #if GET_TIME_STATS
 
 struct PerPassTimeStat
@@ -205,6 +249,36 @@ struct PerPassTimeStat
     uint64_t PassClockStart = 0;
     uint64_t PassElapsedTime = 0;
     int PassHitCount = 0;
+    // Only recorded for vISA optimizer passes.
+    int64_t PassArenaBytes = 0;
+    int64_t PassInstCountDelta = 0;
+};
+
+/// VISA timer values and vISA optimizer pass statistics of one thread. VISA timers
+/// are thread local, so a compile finalized on a worker thread reads them there and
+/// hands them to the thread that owns the TimeStats.
+struct VISATimerReadings
+{
+    struct Timer
+    {
+        int64_t ticks;
+        unsigned int hits;
+    };
+    struct Pass
+    {
+        const char* name;
+        int64_t ticks;
+        int64_t arenaBytes;
+        int64_t instDelta;
+        unsigned int hits;
+    };
+    std::vector<Timer> timers;
+    std::vector<Pass> passes;
+
+    /// Read the VISA timers of the calling thread
+    static VISATimerReadings read();
+    /// Add the readings of another thread
+    void add(const VISATimerReadings& other);
 };
 
 class TimeStats
@@ -213,13 +287,19 @@ public:
     TimeStats();
     ~TimeStats();
 
-    /// Capture the VISA timer values for the most recent call to VISABuilder::compile()
+    /// Capture the VISA timer values for the most recent call to VISABuilder::compile(),
+    /// and the per pass statistics of the vISA optimizer if per pass stats are enabled
     void recordVISATimers();
+    /// Same, for timer values read with VISATimerReadings::read()
+    void recordVISATimers(const VISATimerReadings& readings);
 
     /// Mark that a particular timer has started timing
     void recordTimerStart( COMPILE_TIME_INTERVALS compileInterval );
     /// Mark that a particular timer has finished timing
     void recordTimerEnd( COMPILE_TIME_INTERVALS compileInterval );
+    /// Same, for a timing that started at startTick (from iSTD::GetTimestampCounter()),
+    /// when the timer may have been restarted since
+    void recordTimerEnd( COMPILE_TIME_INTERVALS compileInterval, uint64_t startTick );
 
     /// Get the total elapsed time recorded for a particular timer
     uint64_t getCompileTime( COMPILE_TIME_INTERVALS compileInterval ) const;
@@ -283,6 +363,8 @@ private:
     // Per Pass timestats
     uint64_t m_PassTotalTicks;
     std::map<std::string, PerPassTimeStat> m_PassTimeStatsMap;
+    // vISA optimizer passes, a breakdown of the EmitPass time
+    std::map<std::string, PerPassTimeStat> m_VISAPassTimeStatsMap;
 };
 
 #define COMPILER_TIME_GETNS(pointer, timerName) \
@@ -296,6 +378,7 @@ private:
         { \
                 (pointer)->m_compilerTimeStats->recordTimerStart( compileTimeInterval );  \
         } \
+        ::IGC::TraceEvents::begin( g_cCompTimeIntervals[compileTimeInterval], "IGC" ); \
     } while (0)
 #define COMPILER_TIME_END( pointer, compileTimeInterval ) \
     do \
@@ -304,6 +387,7 @@ private:
         { \
                 (pointer)->m_compilerTimeStats->recordTimerEnd( compileTimeInterval ); \
         } \
+        ::IGC::TraceEvents::end( g_cCompTimeIntervals[compileTimeInterval], "IGC" ); \
     } while (0)
 
 #define COMPILER_TIME_PASS_START( pointer, name ) \
@@ -341,6 +341,7 @@ DECLARE_IGC_REGKEY(bool, EnableScalarizerDebugLog,      false, "print step by st
 DECLARE_IGC_REGKEY(bool, DumpTimeStats,                 false, "Timing of translation, code generation, finalizer, etc", true)
 DECLARE_IGC_REGKEY(bool, DumpTimeStatsCoarse,           false, "Only collect/dump coarse level time stats, i.e. skip opt detail timer for now", true)
 DECLARE_IGC_REGKEY(bool, DumpTimeStatsPerPass,          false, "Collect Timing of IGC/LLVM passes", true)
+DECLARE_IGC_REGKEY(debugString, TraceEventsFile,       0,     "If set, record begin/end events of IGC intervals, LLVM passes, kernel SIMD variants and vISA phases per thread and append them to this file in batches as Chrome trace event JSON; the file is completed at process exit", true)
 DECLARE_IGC_REGKEY(bool, DumpHasNonKernelArgLdSt,       false, "Print if hasNonKernelArg load/store to stderr", true)
 DECLARE_IGC_REGKEY(bool, PrintPsoDdiHash,               true,  "Print psoDDIHash in TimeStats_Shaders.csv file", true)
 DECLARE_IGC_REGKEY(bool, AddExtraIntfInfo,                false, "Will add extra inteference info from .extraintf files from c:\\Intel\\IGC\\ShaderOverride", false)
@@ -366,6 +367,10 @@ DECLARE_IGC_GROUP("IGC Features")
 DECLARE_IGC_REGKEY(bool, EnableOCLSIMD16,               true,  "Enable OCL SIMD16 mode", true)
 DECLARE_IGC_REGKEY(bool, EnableOCLSIMD32,               true,  "Enable OCL SIMD32 mode", true)
 DECLARE_IGC_REGKEY(DWORD, ForceOCLSIMDWidth,            0,     "Force using SIMD width specified. 0 : no forcing. This overrides driver forced SIMD value(if any) and runtime behaviour could be different if driver expects something fixed", true)
+DECLARE_IGC_REGKEY(bool, SpeculativeSIMDCodeGen,        false, "Finalize the SIMD32/16/8 variants of an OCL kernel concurrently and select the widest one that does not abort on spill, instead of compiling them one after another", true)
+DECLARE_IGC_REGKEY(bool, EnableBiFSnapshot,             false, "Import OCL built-ins from a snapshot of the built-in modules that is parsed once per process, instead of loading the modules for every compilation", true)
+DECLARE_IGC_REGKEY(DWORD, BiFSnapshotCacheSizeKB,       16384, "Memory budget in KB for the built-in slices cached by the BiF snapshot", true)
+DECLARE_IGC_REGKEY(bool, BiFSnapshotVerbose,            false, "Print BiF snapshot cache hits, misses and the bytes and time saved to stderr", true)
 DECLARE_IGC_REGKEY(bool, SendMultipleSIMDModesCS,       true,  "Send multiple SIMD modes for CS", false)
 DECLARE_IGC_REGKEY(DWORD, OCLSIMD16SelectionMask,       6,     "Select SIMD 16 heuristics. Valid values are 0, 1, 2 and 3", false)
 DECLARE_IGC_REGKEY(bool, EnableHSSinglePatchDispatch,   false, "Setting this to 1/true enables SIMD8 single-patch dispatch in HullShader. Default is either SIMD8 single patch/dual patch dispatch based on control point count", false)
@@ -499,6 +504,9 @@ DECLARE_IGC_REGKEY(bool, LateInlineUnmaskedFunc,        false, "Postpone inlinin
 DECLARE_IGC_REGKEY(bool, ForceFormatConversionDG2Plus,  false,
     "Forces SW image format conversion for R10G10B10A2_UNORM, R11G11B10_FLOAT, R10G10B10A2_UINT image formats on DG2+ platforms", true)
 DECLARE_IGC_REGKEY(bool, ForceSingleSourceRTWAfterDualSourceRTW, false, "Force the compiler to always send single-source RTW after the dual-source RTW", false)
+DECLARE_IGC_REGKEY(debugString, ProgramCacheDir,        0,     "Enables the persistent OCL program binary cache in the given directory. Entries are keyed by input, options, platform and IGC revision", true)
+DECLARE_IGC_REGKEY(DWORD, ProgramCacheMaxSizeMB,        1024,  "Size limit of the program binary cache in MB; least recently used entries are evicted. 0 means no limit", true)
+DECLARE_IGC_REGKEY(bool, ProgramCacheVerbose,           false, "Print program binary cache hits, misses and stores to stderr", true)
 
 DECLARE_IGC_GROUP("Performance experiments")
 DECLARE_IGC_REGKEY(bool, ForceNonCoherentStatelessBTI,  false, "Enable gneeration of non cache coherent stateless messages", false)
@@ -760,3 +768,4 @@ DECLARE_IGC_GROUP("VectorCompiler Options")
                        "Do not override stack calls linkage as internal", true)
     DECLARE_IGC_REGKEY(bool, VCDirectCallsOnly, false, "Generate code under the assumption all unknown calls are direct", true)
     DECLARE_IGC_REGKEY(DWORD, VCLoopUnrollThreshold, 0, "Set the loop unroll threshold for VC. Value 0 will use the default threshold.", true)
+    DECLARE_IGC_REGKEY(DWORD, VCFinalizerThreads, 0, "Number of threads finalizing the kernels of a VC module. Values 0 and 1 finalize kernels sequentially.", true)
@@ -8,17 +8,146 @@ SPDX-License-Identifier: MIT
 
 #include "Arena.h"
 
-#ifdef COLLECT_ALLOCATION_STATS
-int numAllocations = 0;
-int numMallocCalls = 0;
-int totalAllocSize = 0;
-int totalMallocSize = 0;
-int numMemManagers = 0;
-int maxArenaLength = 0;
-int currentMallocSize = 0;
-#endif
+#include <vector>
+
 using namespace vISA;
 
+namespace
+{
+// Set once the pool of the thread is gone, later frees go to the heap.
+thread_local bool arenaPoolDestroyed = false;
+
+// Free arenas retained by one thread, by power of two data size.
+class ArenaPool
+{
+public:
+    static const unsigned MIN_SIZE_CLASS = 10;  // 1 KB
+    static const unsigned MAX_SIZE_CLASS = 24;  // 16 MB
+
+    ~ArenaPool()
+    {
+        arenaPoolDestroyed = true;
+        for (auto& freeList : freeLists)
+        {
+            for (unsigned char* arena : freeList)
+            {
+                delete [] arena;
+            }
+        }
+    }
+
+    // Returns the size class of dataSize, or 0 if such arenas are not pooled.
+    static unsigned getSizeClass(size_t dataSize)
+    {
+        unsigned sizeClass = MIN_SIZE_CLASS;
+        while (((size_t)1 << sizeClass) < dataSize)
+        {
+            if (++sizeClass > MAX_SIZE_CLASS)
+            {
+                return 0;
+            }
+        }
+        return sizeClass;
+    }
+
+    unsigned char* get(unsigned sizeClass)
+    {
+        auto& freeList = freeLists[sizeClass - MIN_SIZE_CLASS];
+        if (freeList.empty())
+        {
+            return nullptr;
+        }
+        unsigned char* arena = freeList.back();
+        freeList.pop_back();
+        retainedBytes -= (size_t)1 << sizeClass;
+        return arena;
+    }
+
+    bool put(unsigned char* arena, unsigned sizeClass, size_t limit)
+    {
+        const size_t bytes = (size_t)1 << sizeClass;
+        if (retainedBytes + bytes > limit)
+        {
+            return false;
+        }
+        freeLists[sizeClass - MIN_SIZE_CLASS].push_back(arena);
+        retainedBytes += bytes;
+        Counters::max(CounterID::ARENA_POOL_PEAK_BYTES, retainedBytes);
+        return true;
+    }
+
+    // Frees arenas, largest first, until at most limit bytes are retained.
+    void trim(size_t limit)
+    {
+        for (unsigned i = MAX_SIZE_CLASS - MIN_SIZE_CLASS + 1; i-- > 0 && retainedBytes > limit;)
+        {
+            auto& freeList = freeLists[i];
+            while (!freeList.empty() && retainedBytes > limit)
+            {
+                delete [] freeList.back();
+                freeList.pop_back();
+                retainedBytes -= (size_t)1 << (i + MIN_SIZE_CLASS);
+            }
+        }
+    }
+
+private:
+    std::vector<unsigned char*> freeLists[MAX_SIZE_CLASS - MIN_SIZE_CLASS + 1];
+    size_t retainedBytes = 0;
+};
+
+// Set by the builder compiling on this thread, see Mem_Manager::ArenaPoolScope.
+thread_local size_t poolLimit = 0;
+
+ArenaPool* getArenaPool()
+{
+    if (arenaPoolDestroyed)
+    {
+        return nullptr;
+    }
+    static thread_local ArenaPool pool;
+    return &pool;
+}
+} // namespace
+
+unsigned char* ArenaManager::AllocArenaMemory(size_t& dataSize)
+{
+    if (unsigned sizeClass = ArenaPool::getSizeClass(dataSize))
+    {
+        dataSize = (size_t)1 << sizeClass;
+        ArenaPool* pool = getArenaPool();
+        if (unsigned char* arena = pool ? pool->get(sizeClass) : nullptr)
+        {
+            Counters::add(CounterID::ARENAS_RECYCLED, 1);
+            return arena;
+        }
+    }
+    return new unsigned char[ArenaHeader::GetArenaSize(dataSize)];
+}
+
+void ArenaManager::FreeArenaMemory(unsigned char* arena, size_t dataSize)
+{
+    // Only arenas whose size was rounded up to a size class are pooled.
+    unsigned sizeClass = ArenaPool::getSizeClass(dataSize);
+    ArenaPool* pool = getArenaPool();
+    if (sizeClass == 0 || ((size_t)1 << sizeClass) != dataSize || !pool ||
+        !pool->put(arena, sizeClass, poolLimit))
+    {
+        delete [] arena;
+    }
+}
+
+size_t ArenaManager::SetPoolLimit(size_t bytes)
+{
+    size_t prevLimit = poolLimit;
+    poolLimit = bytes;
+    if (bytes < prevLimit && !arenaPoolDestroyed)
+    {
+        getArenaPool()->trim(bytes);
+    }
+    return prevLimit;
+}
+
 void*
 ArenaHeader::AllocSpace(size_t size, size_t al)
 {
@@ -49,14 +178,17 @@ ArenaHeader::AllocSpace(size_t size, size_t al)
 void
 ArenaManager::FreeArenas()
 {
+    Counters::add(CounterID::ARENA_ALLOCATIONS, _numAllocations);
+    Counters::add(CounterID::ARENA_ALLOCATED_BYTES, _allocatedBytes);
+    _numAllocations = 0;
+    _allocatedBytes = 0;
+
     while (_arenas)
     {
-#ifdef COLLECT_ALLOCATION_STATS
-        currentMallocSize -= _arenas->size;
-#endif
         unsigned char* killed = (unsigned char*) _arenas;
+        size_t killedSize = _arenas->size;
         _arenas = _arenas->_nextArena;
-        delete [] killed;
+        FreeArenaMemory(killed, killedSize);
     }
 
     _arenas = 0;
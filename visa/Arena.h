@@ -19,18 +19,7 @@ SPDX-License-Identifier: MIT
 #include <cstddef>
 
 #include "Option.h"
-
-//#define COLLECT_ALLOCATION_STATS
-
-#ifdef COLLECT_ALLOCATION_STATS
-extern int numAllocations;
-extern int numMallocCalls;
-extern int totalAllocSize;
-extern int totalMallocSize;
-extern int numMemManagers;
-extern int maxArenaLength;
-extern int currentMallocSize;
-#endif
+#include "Counters.h"
 
 namespace vISA
 {
@@ -116,6 +105,7 @@ namespace vISA
             _arenas(0),
             _defaultArenaSize(defaultArenaSize)
         {
+            Counters::add(CounterID::MEM_MANAGERS, 1);
             CreateArena(_defaultArenaSize);
         }
 
@@ -126,6 +116,11 @@ namespace vISA
 
         void* AllocDataSpace(size_t size, size_t al)
         {
+            // Published to the counters when the arenas are freed, keeping
+            // the allocation path free of shared state.
+            _numAllocations++;
+            _allocatedBytes += size;
+
             // Do separate memory allocations of debugMemAlloc is set, to allow
             // valgrind/drmemory to find more buffer over-reads/writes
 #if !defined(NDEBUG) && defined(vISA_DEBUG_MEM_ALLOC)
@@ -146,11 +141,6 @@ namespace vISA
                 assert(space);
             }
 
-#ifdef COLLECT_ALLOCATION_STATS
-            numAllocations++;
-            totalAllocSize += size;
-#endif
-
             return space;
         }
 
@@ -158,8 +148,7 @@ namespace vISA
         {
             size_t arenaDataSize = (size > _defaultArenaSize) ? size : _defaultArenaSize;
             arenaDataSize = ArenaHeader::DefaultAlign(arenaDataSize);
-            unsigned char * arena =
-                new unsigned char[ArenaHeader::GetArenaSize(arenaDataSize)];
+            unsigned char * arena = AllocArenaMemory(arenaDataSize);
 
             ArenaHeader* newArena = new (arena)ArenaHeader(arenaDataSize, _arenas);
             // Add new arena to the head of queue
@@ -170,34 +159,39 @@ namespace vISA
 
             _arenas = newArena;
 
-#ifdef COLLECT_ALLOCATION_STATS
-            numMallocCalls++;
-            totalMallocSize += arenaDataSize;
-            currentMallocSize += arenaDataSize;
-            int numArenas = 0;
-            for (ArenaHeader *tmpArena = _arenas; tmpArena != NULL; tmpArena = tmpArena->_nextArena)
-            {
-                numArenas++;
-            }
-            if (numArenas > maxArenaLength)
-            {
-                maxArenaLength = numArenas;
-            }
-            if (numArenas == 1)
-            {
-                numMemManagers++;
-            }
-#endif
+            _numArenas++;
+            _arenaBytes += arenaDataSize;
+            Counters::add(CounterID::ARENAS_CREATED, 1);
+            Counters::add(CounterID::ARENA_BYTES, arenaDataSize);
+            Counters::max(CounterID::MEM_MANAGER_PEAK_BYTES, _arenaBytes);
+            Counters::max(CounterID::MEM_MANAGER_MAX_ARENAS, _numArenas);
 
             return _arenas;
         }
 
         void FreeArenas();
 
+        // Freed arenas are kept in a pool of the freeing thread and handed
+        // out again by size class (powers of two), which saves the malloc
+        // calls and page faults of creating the same arenas for every
+        // kernel. AllocArenaMemory may round dataSize up to its size class.
+        static unsigned char* AllocArenaMemory(size_t& dataSize);
+        static void FreeArenaMemory(unsigned char* arena, size_t dataSize);
+        // Bytes of free arenas the calling thread may retain, 0 (the
+        // default) disables the pool. Returns the previous limit.
+        static size_t SetPoolLimit(size_t bytes);
+
         // Data
 
         ArenaHeader * _arenas;
         const size_t  _defaultArenaSize;
+
+        // Statistics of this manager; arenas are only freed all at once, so
+        // _arenaBytes is also the peak.
+        size_t        _numAllocations = 0;
+        size_t        _allocatedBytes = 0;
+        size_t        _arenaBytes = 0;
+        unsigned      _numArenas = 0;
     };
 }
 #endif
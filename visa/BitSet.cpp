@@ -193,29 +193,28 @@ static BITSET_ARRAY_TYPE maskTrailingZeros(unsigned n)
     return ~maskTrailingOnes(n);
 }
 
-// TODO: Use c++20 bit manipulation utility functions.
 static unsigned countTrailingZeros(BITSET_ARRAY_TYPE val)
 {
     assert(val != 0);
-    unsigned count = 0;
-    while ((val & 1) == 0)
-    {
-        val >>= 1;
-        ++count;
-    }
-    return count;
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, (unsigned long)val);
+    return index;
+#else
+    return __builtin_ctz(val);
+#endif
 }
 
 static unsigned countLeadingZeros(BITSET_ARRAY_TYPE val)
 {
     assert(val != 0);
-    unsigned count = 0;
-    while ((val & (1 << (NUM_BITS_PER_ELT - 1))) == 0)
-    {
-        val <<= 1;
-        ++count;
-    }
-    return count;
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, (unsigned long)val);
+    return NUM_BITS_PER_ELT - 1 - index;
+#else
+    return __builtin_clz(val);
+#endif
 }
 
 int BitSet::findFirstIn(unsigned begin, unsigned end) const
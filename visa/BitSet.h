@@ -12,7 +12,9 @@ SPDX-License-Identifier: MIT
 #include "Mem_Manager.h"
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 #include <map>
+#include <vector>
 
 // Array-based bitset implementation where each element occupies a single bit.
 // Inside each array element, bits are stored and indexed from lsb to msb.
@@ -441,18 +443,56 @@ public:
 // corresponding ones.
 class SparseBitSet {
     // SparseBitSet is a collection of segments, i.e. a BitSet with fixed size,
-    // says 64, 128 or 256 bits. That collection is organized as a
-    // self-balanced tree to speed up the lookup and insertion.
+    // says 64, 128 or 256 bits. That collection is kept ordered by segment
+    // index to speed up the lookup and the simultaneous scans done by the set
+    // operations.
     static const unsigned SegmentBitSize = 2048;
     static const unsigned SegmentEltSize = SegmentBitSize / NUM_BITS_PER_ELT;
-    // `std::map` is used as the container to prevent reinventing the wheel as
+    using Segment = FixedBitSet<SegmentBitSize>;
+#ifdef VISA_USE_MAP_SPARSE_BITSET
     // `std::map` is usually implemented as red-black trees, one kind of
-    // self-balanced binary search trees
-    std::map<unsigned, FixedBitSet<SegmentBitSize>> Segments;
+    // self-balanced binary search trees.
+    using SegmentContainer = std::map<unsigned, Segment>;
+#else
+    // By default segments are stored contiguously in a vector sorted by
+    // segment index. Lookup is a binary search, and union/intersection/
+    // difference become linear merges over contiguous memory instead of
+    // pointer chasing through tree nodes.
+    using SegmentContainer = std::vector<std::pair<unsigned, Segment>>;
+#endif
+    SegmentContainer Segments;
 
     unsigned MaxBits;
 
 protected:
+    SegmentContainer::iterator lowerBoundSegment(unsigned Seg) {
+#ifdef VISA_USE_MAP_SPARSE_BITSET
+        return Segments.lower_bound(Seg);
+#else
+        return std::lower_bound(Segments.begin(), Segments.end(), Seg,
+            [](const SegmentContainer::value_type &S, unsigned Idx) { return S.first < Idx; });
+#endif
+    }
+
+    SegmentContainer::const_iterator findSegment(unsigned Seg) const {
+#ifdef VISA_USE_MAP_SPARSE_BITSET
+        return Segments.find(Seg);
+#else
+        auto I = std::lower_bound(Segments.begin(), Segments.end(), Seg,
+            [](const SegmentContainer::value_type &S, unsigned Idx) { return S.first < Idx; });
+        return (I != Segments.end() && I->first == Seg) ? I : Segments.end();
+#endif
+    }
+
+    // Insert an empty segment `Seg` at `Pos`, which must be its lower bound.
+    SegmentContainer::iterator insertSegment(SegmentContainer::iterator Pos, unsigned Seg) {
+#ifdef VISA_USE_MAP_SPARSE_BITSET
+        return Segments.emplace_hint(Pos, Seg, Segment());
+#else
+        return Segments.emplace(Pos, Seg, Segment());
+#endif
+    }
+
     // Helper function to map a bit index into its segment index.
     std::pair<unsigned, unsigned> bitToSegPair(unsigned Bit) const {
         return std::make_pair(Bit / SegmentBitSize, Bit % SegmentBitSize);
@@ -482,24 +522,16 @@ public:
     void resize(unsigned Bits) {
         unsigned Segs = roundUpToSegments(Bits);
         if (Segs < roundUpToSegments(MaxBits)) {
-            for (auto I = Segments.begin(),
-                      E = Segments.end(); I != E; /*EMPTY*/) {
-                if (I->first < Segs) {
-                    // Skip segments in range.
-                    ++I;
-                    continue;
-                }
-                // Erase segments beyond.
-                I = Segments.erase(I);
-            }
+            // Segments are sorted; erase those beyond the new size.
+            Segments.erase(lowerBoundSegment(Segs), Segments.end());
         }
         MaxBits = Bits;
     }
 
     class SparseBitSetIterator {
         const SparseBitSet *Set;
-        std::map<unsigned, FixedBitSet<SegmentBitSize>>::const_iterator MI;
-        std::map<unsigned, FixedBitSet<SegmentBitSize>>::const_iterator ME;
+        SegmentContainer::const_iterator MI;
+        SegmentContainer::const_iterator ME;
         BITSET_ARRAY_TYPE CachedWord;
         unsigned Elt; // The elt number in that segment.
         unsigned Bit; // The bit number in that element.
@@ -609,7 +641,7 @@ public:
             return false;
         unsigned Seg, BitInSeg;
         std::tie(Seg, BitInSeg) = bitToSegPair(Bit);
-        auto I = Segments.find(Seg);
+        auto I = findSegment(Seg);
         if (I == Segments.end())
             return false;
         return I->second.isSet(BitInSeg);
@@ -622,12 +654,12 @@ public:
         MaxBits = std::max(MaxBits, Bit + 1);
         unsigned Seg, BitInSeg;
         std::tie(Seg, BitInSeg) = bitToSegPair(Bit);
-        auto I = Segments.find(Seg);
-        if (I == Segments.end()) {
+        auto I = lowerBoundSegment(Seg);
+        if (I == Segments.end() || I->first != Seg) {
             // Ignore if just to clear the bit not present.
             if (!Val)
                 return;
-            I = Segments.emplace(Seg, FixedBitSet<SegmentBitSize>()).first;
+            I = insertSegment(I, Seg);
         }
         I->second.set(BitInSeg, Val);
     }
@@ -638,7 +670,7 @@ public:
     BITSET_ARRAY_TYPE getElt(unsigned Elt) const {
         unsigned Seg, EltInSeg;
         std::tie(Seg, EltInSeg) = eltToSegPair(Elt);
-        auto I = Segments.find(Seg);
+        auto I = findSegment(Seg);
         if (I == Segments.end())
             return 0;
         return I->second.getElt(EltInSeg);
@@ -658,6 +690,26 @@ public:
     }
 
     SparseBitSet &operator&=(const SparseBitSet &Other) {
+#ifndef VISA_USE_MAP_SPARSE_BITSET
+        // Compact the surviving segments in place.
+        auto Out = Segments.begin();
+        auto OI = Other.Segments.begin(), OE = Other.Segments.end();
+        for (auto I = Segments.begin(), E = Segments.end(); I != E; ++I) {
+            while (OI != OE && OI->first < I->first)
+                ++OI;
+            if (OI == OE)
+                break;
+            if (OI->first != I->first)
+                continue;
+            I->second &= OI->second;
+            if (I->second.isEmpty())
+                continue;
+            if (Out != I)
+                *Out = *I;
+            ++Out;
+        }
+        Segments.erase(Out, Segments.end());
+#else
         auto I = Segments.begin(), E = Segments.end();
         // Skip when this is empty.
         if (I == E)
@@ -687,6 +739,7 @@ public:
         // Erase all remaining segments.
         while (I != E)
             I = Segments.erase(I);
+#endif
         MaxBits = std::min(MaxBits, Other.MaxBits);
         return *this;
     }
@@ -696,6 +749,44 @@ public:
         // Skip when the other is empty.
         if (OI == OE)
             return *this;
+#ifndef VISA_USE_MAP_SPARSE_BITSET
+        // Count segments only present in other. If there are none, which is
+        // the common case once liveness converges, `or` in place; otherwise
+        // merge both sorted sequences into a new vector.
+        unsigned NumNew = 0;
+        for (auto I = Segments.cbegin(), E = Segments.cend(); OI != OE; ++OI) {
+            while (I != E && I->first < OI->first)
+                ++I;
+            if (I == E || I->first != OI->first)
+                ++NumNew;
+        }
+        OI = Other.Segments.begin();
+        if (NumNew == 0) {
+            auto I = Segments.begin();
+            for (; OI != OE; ++OI) {
+                while (I->first < OI->first)
+                    ++I;
+                I->second |= OI->second;
+            }
+        } else {
+            SegmentContainer Merged;
+            Merged.reserve(Segments.size() + NumNew);
+            auto I = Segments.cbegin(), E = Segments.cend();
+            for (; OI != OE; ++OI) {
+                for (; I != E && I->first < OI->first; ++I)
+                    Merged.push_back(*I);
+                if (I != E && I->first == OI->first) {
+                    Merged.push_back(*I);
+                    Merged.back().second |= OI->second;
+                    ++I;
+                } else {
+                    Merged.push_back(*OI);
+                }
+            }
+            Merged.insert(Merged.end(), I, E);
+            Segments.swap(Merged);
+        }
+#else
         auto I = Segments.begin(), E = Segments.end();
         // Scan this and other simultaneously.
         while (OI != OE) {
@@ -716,6 +807,7 @@ public:
             while (I != E && I->first < OI->first)
                 ++I;
         }
+#endif
         MaxBits = std::max(MaxBits, Other.MaxBits);
         return *this;
     }
@@ -726,6 +818,23 @@ public:
         // Skip when either this or other is empty.
         if (OI == OE || I == E)
             return *this;
+#ifndef VISA_USE_MAP_SPARSE_BITSET
+        // Compact the non-empty segments in place.
+        auto Out = Segments.begin();
+        for (; I != E; ++I) {
+            while (OI != OE && OI->first < I->first)
+                ++OI;
+            if (OI != OE && OI->first == I->first) {
+                I->second -= OI->second;
+                if (I->second.isEmpty())
+                    continue;
+            }
+            if (Out != I)
+                *Out = *I;
+            ++Out;
+        }
+        Segments.erase(Out, Segments.end());
+#else
         // Scan two sparse bitsets simultaneously.
         while (I != E && OI != OE) {
             if (OI->first == I->first) {
@@ -749,6 +858,7 @@ public:
             if (OI == OE)
                 break;
         }
+#endif
         return *this;
     }
 
@@ -773,8 +883,8 @@ public:
 
     class SparseBitSetAndIterator {
         const SparseBitSet *LHS, *RHS;
-        std::map<unsigned, FixedBitSet<SegmentBitSize>>::const_iterator LI, RI;
-        std::map<unsigned, FixedBitSet<SegmentBitSize>>::const_iterator LE, RE;
+        SegmentContainer::const_iterator LI, RI;
+        SegmentContainer::const_iterator LE, RE;
         BITSET_ARRAY_TYPE CachedWord; // Cached result from the matching elements.
         unsigned Elt, Bit;
 
@@ -106,6 +106,8 @@ public:
 
     int verifyVISAIR();
 
+    bool canCompileKernelsInParallel() const;
+
 
     static void cat(std::stringstream &ss) { }
     template <typename T, typename...Ts>
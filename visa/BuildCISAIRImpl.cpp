@@ -18,6 +18,7 @@ SPDX-License-Identifier: MIT
 #include "VISAKernel.h"
 #include "BinaryCISAEmission.h"
 #include "Timer.h"
+#include "Counters.h"
 #include "BinaryEncoding.h"
 #include "IsaDisassembly.h"
 
@@ -34,6 +35,10 @@ SPDX-License-Identifier: MIT
 #include <sstream>
 #include <functional>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 using namespace vISA;
 extern "C" int64_t getTimerTicks(unsigned int idx);
@@ -1402,9 +1407,92 @@ int CISA_IR_Builder::ParseVISAText(const std::string& visaFile)
 
 // default size of the kernel mem manager in bytes
 #define KERNEL_MEM_SIZE    (4*1024*1024)
+
+// Kernels may be compiled concurrently only if none of them is stitched with
+// another unit: every entry must be a kernel, and no code patching, payload
+// section or subroutine linking is requested. Each VISAKernelImpl owns its
+// IR_Builder, G4_Kernel and Mem_Manager, so such kernels share no IR.
+bool CISA_IR_Builder::canCompileKernelsInParallel() const
+{
+    if (m_options.getuInt32Option(vISA_NumCompileThreads) <= 1 ||
+        m_kernelsAndFunctions.size() <= 1 ||
+        m_options.getuInt32Option(vISA_CodePatch) ||
+        m_options.getuInt32Option(vISA_Linker) ||
+        m_prevKernel)
+    {
+        return false;
+    }
+    for (const VISAKernelImpl* func : m_kernelsAndFunctions)
+    {
+        if (!func->getIsKernel() || func->getIsPayload())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Run compileFn on every kernel in kernels using up to numThreads worker
+// threads. Kernels are handed out in list order; results are stored in the
+// kernels themselves, so the output does not depend on scheduling. Timers of
+// the workers are added to the calling thread's. Returns the status of the
+// first failing kernel in list order.
+static int runOnKernelsInParallel(
+    const std::vector<VISAKernelImpl*>& kernels, unsigned numThreads,
+    TARGET_PLATFORM platform, size_t arenaPoolLimit,
+    const std::function<int(VISAKernelImpl*)>& compileFn)
+{
+    std::vector<int> status(kernels.size(), VISA_SUCCESS);
+    std::atomic<size_t> nextKernel(0);
+    numThreads = std::min<unsigned>(numThreads, (unsigned)kernels.size());
+    std::vector<TimerReadings> workerTimers(numThreads);
+    auto worker = [&](unsigned workerId)
+    {
+        // visa platform, timers and arena pool are thread local
+        SetVisaPlatform(platform);
+        initTimer();
+        Mem_Manager::ArenaPoolScope arenaPool(arenaPoolLimit);
+        for (size_t i = nextKernel++; i < kernels.size(); i = nextKernel++)
+        {
+            status[i] = compileFn(kernels[i]);
+        }
+        workerTimers[workerId] = saveTimers();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (unsigned i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    for (const TimerReadings& readings : workerTimers)
+    {
+        mergeTimers(readings);
+    }
+
+    for (int s : status)
+    {
+        if (s != VISA_SUCCESS)
+        {
+            return s;
+        }
+    }
+    return VISA_SUCCESS;
+}
+
 int CISA_IR_Builder::Compile(const char* nameInput, std::ostream* os, bool emit_visa_only)
 {
+    // the visa platform is thread local and the builder may be compiled on a
+    // different thread than the one that created it
+    SetVisaPlatform(m_platformInfo->platform);
     stopTimer(TimerID::BUILDER);   // TIMER_BUILDER is started when builder is created
+    // arenas of this builder's compile are reused only by this compile
+    const size_t arenaPoolLimit = (size_t)m_options.getuInt32Option(vISA_ArenaPoolSizeKB) * 1024;
+    Mem_Manager::ArenaPoolScope arenaPool(arenaPoolLimit);
     int status = VISA_SUCCESS;
     std::string name = std::string(nameInput);
 
@@ -1533,6 +1621,9 @@ int CISA_IR_Builder::Compile(const char* nameInput, std::ostream* os, bool emit_
         uint32_t localScheduleStartKernelId = m_options.getuInt32Option(vISA_LocalScheduleingStartKernel);
         uint32_t localScheduleEndKernelId = m_options.getuInt32Option(vISA_LocalScheduleingEndKernel);
         VISAKernelImpl* mainKernel = nullptr;
+        const bool compileInParallel = canCompileKernelsInParallel();
+        const unsigned numCompileThreads = m_options.getuInt32Option(vISA_NumCompileThreads);
+        std::vector<VISAKernelImpl*> kernelsToCompile;
         std::list<VISAKernelImpl*>::iterator iter = m_kernelsAndFunctions.begin();
         std::list<VISAKernelImpl*>::iterator end = m_kernelsAndFunctions.end();
         for (i = 0; iter != end; iter++, i++)
@@ -1593,6 +1684,11 @@ int CISA_IR_Builder::Compile(const char* nameInput, std::ostream* os, bool emit_
             {
                 continue;
             }
+            if (compileInParallel)
+            {
+                kernelsToCompile.push_back(kernel);
+                continue;
+            }
             int status =  kernel->compileFastPath();
             if (status != VISA_SUCCESS)
             {
@@ -1615,6 +1711,17 @@ int CISA_IR_Builder::Compile(const char* nameInput, std::ostream* os, bool emit_
                 }
             }
         }
+        if (!kernelsToCompile.empty())
+        {
+            int status = runOnKernelsInParallel(kernelsToCompile, numCompileThreads,
+                m_platformInfo->platform, arenaPoolLimit,
+                [](VISAKernelImpl* kernel) { return kernel->compileFastPath(); });
+            if (status != VISA_SUCCESS)
+            {
+                stopTimer(TimerID::TOTAL);
+                return status;
+            }
+        }
         // Here we change the payload section as the main kernel in m_kernelsAndFunctions
         // During stitching, all functions will be cloned and stitched to the main kernel.
         // Demoting the shader body to a function type makes it intact
@@ -1745,7 +1852,7 @@ int CISA_IR_Builder::Compile(const char* nameInput, std::ostream* os, bool emit_
 
         bool hasPayloadPrologue = m_options.getuInt32Option(vISA_CodePatch) >= CodePatch_Payload_Prologue;
         // stitch functions and compile to gen binary
-        for (auto func : mainFunctions)
+        auto compileMainFunction = [&](VISAKernelImpl* func)
         {
             unsigned int genxBufferSize = 0;
 
@@ -1782,9 +1889,28 @@ int CISA_IR_Builder::Compile(const char* nameInput, std::ostream* os, bool emit_
                 func->computeAndEmitDebugInfo(subFunctions);
             }
             restoreFCallState(func->getKernel(), origFCallFRet);
+            return VISA_SUCCESS;
+        };
 
+        if (compileInParallel)
+        {
+            // no sub-functions to stitch, so every kernel is finalized on its own
+            std::vector<VISAKernelImpl*> kernels(mainFunctions.begin(), mainFunctions.end());
+            int status = runOnKernelsInParallel(kernels, numCompileThreads,
+                m_platformInfo->platform, arenaPoolLimit, compileMainFunction);
+            if (status != VISA_SUCCESS)
+            {
+                stopTimer(TimerID::TOTAL);
+                return status;
+            }
+        }
+        else
+        {
+            for (auto func : mainFunctions)
+            {
+                compileMainFunction(func);
+            }
         }
-
 
     }
 
@@ -1842,6 +1968,12 @@ int CISA_IR_Builder::Compile(const char* nameInput, std::ostream* os, bool emit_
         dumpAllTimers(asmName, true);
     }
 
+    Counters::add(CounterID::COMPILATIONS, 1);
+    if (const char* countersFile = m_options.getOptionCstr(vISA_CountersFile))
+    {
+        Counters::dumpJSON(countersFile);
+    }
+
 #ifndef DLL_MODE
     if (criticalMsg.str().length() > 0)
     {
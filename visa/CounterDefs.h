@@ -0,0 +1,25 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//          ENUM                       KIND  NAME
+// Arena allocations made through Mem_Manager.
+DEF_COUNTER(ARENA_ALLOCATIONS,         SUM,  "allocations")
+DEF_COUNTER(ARENA_ALLOCATED_BYTES,     SUM,  "allocatedBytes")
+// Arenas backing the allocations, including recycled ones.
+DEF_COUNTER(ARENAS_CREATED,            SUM,  "arenas")
+DEF_COUNTER(ARENA_BYTES,               SUM,  "arenaBytes")
+DEF_COUNTER(MEM_MANAGERS,              SUM,  "memManagers")
+// Arenas served from the per-thread pool of freed arenas, and the most
+// memory a thread's pool retained.
+DEF_COUNTER(ARENAS_RECYCLED,           SUM,  "arenasRecycled")
+DEF_COUNTER(ARENA_POOL_PEAK_BYTES,     MAX,  "arenaPoolPeakBytes")
+// Largest footprint and arena list of a single Mem_Manager.
+DEF_COUNTER(MEM_MANAGER_PEAK_BYTES,    MAX,  "memManagerPeakBytes")
+DEF_COUNTER(MEM_MANAGER_MAX_ARENAS,    MAX,  "memManagerMaxArenas")
+// Compilations the counters cover.
+DEF_COUNTER(COMPILATIONS,              SUM,  "compilations")
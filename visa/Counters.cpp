@@ -0,0 +1,225 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "Counters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace vISA;
+
+namespace
+{
+enum CounterKind { SUM, MAX };
+
+#define DEF_COUNTER(ENUM, KIND, NAME) KIND,
+const CounterKind counterKinds[] =
+{
+#include "CounterDefs.h"
+};
+#undef DEF_COUNTER
+
+#define DEF_COUNTER(ENUM, KIND, NAME) NAME,
+const char* const counterNames[] =
+{
+#include "CounterDefs.h"
+};
+#undef DEF_COUNTER
+
+const unsigned NUM_COUNTERS = static_cast<unsigned>(CounterID::NUM_COUNTERS);
+const unsigned NUM_NAMED_COUNTERS = 256;
+
+struct NamedCounter
+{
+    // group and name are written once, before used is set.
+    const char* group = nullptr;
+    const char* name = nullptr;
+    std::atomic<int64_t> value{0};
+    std::atomic<bool> used{false};
+};
+
+struct CounterBlock
+{
+    std::atomic<int64_t> values[NUM_COUNTERS];
+    NamedCounter named[NUM_NAMED_COUNTERS];
+    std::atomic<bool> inUse{true};
+    // Set before the block is published and never changed.
+    CounterBlock* next = nullptr;
+
+    CounterBlock()
+    {
+        for (auto& value : values)
+        {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+// Blocks are added to the head of the list and never freed.
+std::atomic<CounterBlock*> blockList{nullptr};
+
+CounterBlock* claimBlock()
+{
+    for (CounterBlock* block = blockList.load(std::memory_order_acquire); block; block = block->next)
+    {
+        bool expected = false;
+        if (block->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            return block;
+        }
+    }
+    CounterBlock* block = new CounterBlock();
+    block->next = blockList.load(std::memory_order_relaxed);
+    while (!blockList.compare_exchange_weak(block->next, block,
+        std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+    return block;
+}
+
+// Owns the block of a thread and hands it back when the thread exits.
+struct ThreadBlock
+{
+    CounterBlock* block = claimBlock();
+    ~ThreadBlock() { block->inUse.store(false, std::memory_order_release); }
+};
+
+CounterBlock& getBlock()
+{
+    static thread_local ThreadBlock threadBlock;
+    return *threadBlock.block;
+}
+
+void writeJSONString(std::ostream& os, const char* str)
+{
+    os << '"';
+    for (; *str; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+        {
+            os << '\\';
+        }
+        os << *str;
+    }
+    os << '"';
+}
+} // namespace
+
+void Counters::add(CounterID id, int64_t value)
+{
+    std::atomic<int64_t>& counter = getBlock().values[static_cast<unsigned>(id)];
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void Counters::max(CounterID id, int64_t value)
+{
+    std::atomic<int64_t>& counter = getBlock().values[static_cast<unsigned>(id)];
+    if (value > counter.load(std::memory_order_relaxed))
+    {
+        counter.store(value, std::memory_order_relaxed);
+    }
+}
+
+void Counters::addNamed(const char* group, const char* name, int64_t value)
+{
+    NamedCounter* named = getBlock().named;
+    for (unsigned i = 0; i < NUM_NAMED_COUNTERS; ++i)
+    {
+        NamedCounter& counter = named[i];
+        if (!counter.used.load(std::memory_order_relaxed))
+        {
+            counter.group = group;
+            counter.name = name;
+            counter.value.store(value, std::memory_order_relaxed);
+            counter.used.store(true, std::memory_order_release);
+            return;
+        }
+        if (counter.name == name && counter.group == group)
+        {
+            counter.value.store(counter.value.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+int64_t Counters::get(CounterID id)
+{
+    const unsigned index = static_cast<unsigned>(id);
+    int64_t result = 0;
+    for (CounterBlock* block = blockList.load(std::memory_order_acquire); block; block = block->next)
+    {
+        int64_t value = block->values[index].load(std::memory_order_relaxed);
+        result = counterKinds[index] == MAX ? std::max(result, value) : result + value;
+    }
+    return result;
+}
+
+int64_t Counters::getThread(CounterID id)
+{
+    return getBlock().values[static_cast<unsigned>(id)].load(std::memory_order_relaxed);
+}
+
+void Counters::writeJSON(std::ostream& os)
+{
+    // The same string may live at different addresses, so merge by value.
+    std::map<std::string, std::map<std::string, int64_t>> named;
+    unsigned numBlocks = 0;
+    for (CounterBlock* block = blockList.load(std::memory_order_acquire); block; block = block->next)
+    {
+        numBlocks++;
+        for (const NamedCounter& counter : block->named)
+        {
+            if (!counter.used.load(std::memory_order_acquire))
+            {
+                break;
+            }
+            named[counter.group][counter.name] += counter.value.load(std::memory_order_relaxed);
+        }
+    }
+
+    os << "{\"threads\":" << numBlocks;
+    for (unsigned i = 0; i < NUM_COUNTERS; ++i)
+    {
+        os << ",";
+        writeJSONString(os, counterNames[i]);
+        os << ":" << get(static_cast<CounterID>(i));
+    }
+    for (auto& group : named)
+    {
+        os << ",";
+        writeJSONString(os, group.first.c_str());
+        os << ":{";
+        const char* sep = "";
+        for (auto& counter : group.second)
+        {
+            os << sep;
+            writeJSONString(os, counter.first.c_str());
+            os << ":" << counter.second;
+            sep = ",";
+        }
+        os << "}";
+    }
+    os << "}";
+}
+
+void Counters::dumpJSON(const char* fileName)
+{
+    static std::mutex fileMutex;
+    std::lock_guard<std::mutex> lock(fileMutex);
+    std::ofstream os(fileName, std::ios::app);
+    if (os)
+    {
+        writeJSON(os);
+        os << "\n";
+    }
+}
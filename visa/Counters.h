@@ -0,0 +1,59 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef _COUNTERS_H_
+#define _COUNTERS_H_
+
+#include <cstdint>
+#include <ostream>
+
+// Process-wide counters for memory and pass statistics that are cheap
+// enough to stay in release builds.
+//
+// Every thread owns a block of counters and is its only writer, so an update
+// is a relaxed load and store to memory no other thread writes: no locks and
+// no contended cache lines. Readers sum (or take the maximum of) all blocks.
+// The blocks of exited threads are reused by new threads, which keeps the
+// totals intact.
+//
+// To add a counter, update CounterDefs.h.
+#define DEF_COUNTER(ENUM, KIND, NAME) ENUM,
+enum class CounterID
+{
+#include "CounterDefs.h"
+    NUM_COUNTERS
+};
+#undef DEF_COUNTER
+
+namespace vISA
+{
+namespace Counters
+{
+    // Adds value to a SUM counter.
+    void add(CounterID id, int64_t value);
+    // Raises a MAX counter to value.
+    void max(CounterID id, int64_t value);
+    // Adds value to the counter name of group, e.g. the instruction count
+    // after each optimizer pass. Both strings must have static storage
+    // duration. Each thread keeps a fixed number of named counters and drops
+    // names beyond that.
+    void addNamed(const char* group, const char* name, int64_t value);
+
+    int64_t get(CounterID id);
+    // Value of the counter in the block of the calling thread. The
+    // difference of two reads attributes the work in between to a scope.
+    int64_t getThread(CounterID id);
+
+    // Writes all counters as one JSON object (no trailing newline).
+    void writeJSON(std::ostream& os);
+    // Appends the JSON object as a line to fileName.
+    void dumpJSON(const char* fileName);
+}
+}
+
+#endif // _COUNTERS_H_
@@ -21,6 +21,7 @@ SPDX-License-Identifier: MIT
 #include "iga/IGALibrary/api/iga.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
@@ -357,7 +358,8 @@ G4_BB* FlowGraph::createNewBBWithLabel(const char* LabelPrefix, int Lineno, int
     return newBB;
 }
 
-static int globalCount = 1;
+// Kernels may be finalized concurrently.
+static std::atomic<int> globalCount(1);
 
 int64_t FlowGraph::insertDummyUUIDMov()
 {
@@ -376,8 +378,7 @@ int64_t FlowGraph::insertDummyUUIDMov()
         for (auto bb : BBs)
         {
             uint32_t seed = (uint32_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
-            std::mt19937 mt_rand(seed * globalCount);
-            globalCount++;
+            std::mt19937 mt_rand(seed * globalCount++);
 
             G4_DstRegRegion* nullDst = builder->createNullDst(Type_UD);
             int64_t uuID = (int64_t)mt_rand();
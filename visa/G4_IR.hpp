@@ -244,6 +244,11 @@ struct lsc_descriptor {
     uint32_t addr_type  : 2; // [31:30]
 };
 
+// Instruction and def-use lists are node based on purpose: an instruction
+// may be in several INST_LISTs at once, passes replace instructions in place
+// through list iterators, and def-use walks erase edges while holding other
+// iterators into the same list. Intrusive links or a contiguous edge array
+// would break these uses.
 typedef vISA::std_arena_based_allocator<vISA::G4_INST*> INST_LIST_NODE_ALLOCATOR;
 
 typedef std::list<vISA::G4_INST*, INST_LIST_NODE_ALLOCATOR>           INST_LIST;
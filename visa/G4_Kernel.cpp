@@ -1625,6 +1625,11 @@ void G4_Kernel::emitDeviceAsmHeaderComment(std::ostream& os)
         {
             os << "\n" << "//.spill GRF est. ref count " << jitInfo->numGRFSpillFill;
         }
+        if (jitInfo->numScratchBytesMoved > 0)
+        {
+            os << "\n" << "//.scratch bytes moved " << jitInfo->numScratchBytesMoved
+                << " (" << jitInfo->numScratchBytesMovedBeforeCleanup << " before spill cleanup)";
+        }
         if (jitInfo->numFlagSpillStore > 0)
         {
             os << "\n//.spill flag store " << jitInfo->numFlagSpillStore;
@@ -1753,6 +1753,11 @@ inline void Interference::filterSplitDclares(unsigned startIdx, unsigned endIdx,
 //
 void Interference::buildInterferenceWithLive(const SparseBitSet& live, unsigned i)
 {
+    if (replayOnly)
+    {
+        return;
+    }
+
     const LiveRange* lr = lrs[i];
     bool is_partial = lr->getIsPartialDcl();
     bool is_splitted = lr->getIsSplittedDcl();
@@ -2666,6 +2671,171 @@ void Interference::applyPartitionBias()
     }
 }
 
+uint64_t Interference::computeBBSignature(G4_BB* bb)
+{
+    // FNV-1a style hash over instructions and their operands. Spill/fill
+    // insertion either adds instructions or replaces operands, so either
+    // changes the signature. Pseudo kills inserted by liveness are recreated
+    // in every iteration and are identified by the variable they kill.
+    uint64_t sig = 0xcbf29ce484222325ULL;
+    auto mix = [&sig](const void* p)
+    {
+        sig = (sig ^ (uint64_t)(uintptr_t)p) * 0x100000001b3ULL;
+    };
+    auto mixOpnd = [&mix](G4_Operand* opnd)
+    {
+        mix(opnd);
+        mix(opnd ? opnd->getTopDcl() : nullptr);
+    };
+
+    for (G4_INST* inst : *bb)
+    {
+        if (inst->isPseudoKill() && inst->getSrc(0)->isImm() &&
+            inst->getSrc(0)->asImm()->getImm() == PseudoKillType::FromLiveness)
+        {
+            mix(inst->getDst()->getTopDcl());
+            continue;
+        }
+
+        mix(inst);
+        mixOpnd(inst->getDst());
+        for (int i = 0, numSrc = inst->getNumSrc(); i < numSrc; i++)
+        {
+            mixOpnd(inst->getSrc(i));
+        }
+        mixOpnd(inst->getPredicate());
+        mixOpnd(inst->getCondMod());
+    }
+
+    return sig;
+}
+
+void Interference::getLiveOutDcls(const G4_BB* bb, std::vector<G4_Declare*>& dcls) const
+{
+    dcls.clear();
+    const SparseBitSet& useOut = liveAnalysis->use_out[bb->getId()];
+    const SparseBitSet& defOut = liveAnalysis->def_out[bb->getId()];
+    for (auto I = useOut.and_begin(defOut), E = useOut.and_end(defOut); I != E; ++I)
+    {
+        dcls.push_back(lrs[*I]->getDcl());
+    }
+    std::sort(dcls.begin(), dcls.end());
+}
+
+bool Interference::canUseIntfSnapshot() const
+{
+    // Partial/splitted declares can change status between iterations
+    // (see buildInterferenceAmongLiveIns), which changes the edges that
+    // buildInterferenceWithLive filters out, so they are not reused.
+    return gra.intfSnapshot && gra.intfSnapshot->valid &&
+        liveAnalysis->livenessClass(G4_GRF) && splitNum == 0;
+}
+
+//
+// Re-apply edges recorded in the previous iteration and mark BBs whose
+// instructions and live-out set are unchanged as clean. Edges that arise in
+// a BB depend only on those two, so clean BBs need not be rescanned. Edges
+// of variables that are not allocated any more (e.g. spilled ones) are
+// dropped. Edges recorded for dirty BBs are a superset of what a rescan
+// yields for the surviving variables, which is conservative.
+//
+void Interference::restoreIntfSnapshot(std::vector<bool>& dirtyBBs)
+{
+    const IntfSnapshot& snapshot = *gra.intfSnapshot;
+
+    auto getId = [this](G4_Declare* dcl, unsigned& id)
+    {
+        const G4_RegVar* var = dcl->getRegVar();
+        if (!var->isRegAllocPartaker())
+        {
+            return false;
+        }
+        id = var->getId();
+        return id < maxId && lrs[id]->getDcl() == dcl;
+    };
+
+    for (auto&& edge : snapshot.edges)
+    {
+        unsigned v1 = 0, v2 = 0;
+        if (getId(edge.first, v1) && getId(edge.second, v2))
+        {
+            checkAndSetIntf(v1, v2);
+        }
+    }
+
+    unsigned numClean = 0;
+    std::vector<G4_Declare*> liveOut;
+    for (G4_BB* bb : kernel.fg)
+    {
+        unsigned id = bb->getId();
+        if (id >= snapshot.bbSignature.size() ||
+            snapshot.bbSignature[id] != computeBBSignature(bb))
+        {
+            continue;
+        }
+
+        getLiveOutDcls(bb, liveOut);
+        if (liveOut != snapshot.bbLiveOut[id])
+        {
+            continue;
+        }
+
+        dirtyBBs[id] = false;
+        numClean++;
+    }
+
+    if (builder.getOption(vISA_RATrace))
+    {
+        std::cout << "\t--incremental interference: rescanning " <<
+            kernel.fg.size() - numClean << " of " << kernel.fg.size() << " BBs\n";
+    }
+}
+
+void Interference::saveIntfSnapshot()
+{
+    IntfSnapshot& snapshot = *gra.intfSnapshot;
+    snapshot.edges.clear();
+
+    if (useDenseMatrix())
+    {
+        for (unsigned row = 0; row < maxId; row++)
+        {
+            unsigned rowOffset = row * rowSize;
+            for (unsigned j = (row + 1) / BITS_DWORD; j < rowSize; j++)
+            {
+                unsigned intfBlk = matrix[rowOffset + j];
+                for (unsigned k = 0; intfBlk != 0 && k < BITS_DWORD; k++)
+                {
+                    unsigned v2 = j * BITS_DWORD + k;
+                    if ((intfBlk & (1 << k)) && v2 != row)
+                    {
+                        snapshot.edges.emplace_back(lrs[row]->getDcl(), lrs[v2]->getDcl());
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        for (unsigned v1 = 0; v1 < maxId; v1++)
+        {
+            for (uint32_t v2 : sparseMatrix[v1])
+            {
+                snapshot.edges.emplace_back(lrs[v1]->getDcl(), lrs[v2]->getDcl());
+            }
+        }
+    }
+
+    snapshot.bbSignature.assign(kernel.fg.getNumBB(), 0);
+    snapshot.bbLiveOut.assign(kernel.fg.getNumBB(), std::vector<G4_Declare*>());
+    for (G4_BB* bb : kernel.fg)
+    {
+        snapshot.bbSignature[bb->getId()] = computeBBSignature(bb);
+        getLiveOutDcls(bb, snapshot.bbLiveOut[bb->getId()]);
+    }
+    snapshot.valid = true;
+}
+
 void Interference::computeInterference()
 {
     startTimer(TimerID::INTERFERENCE);
@@ -2674,6 +2844,14 @@ void Interference::computeInterference()
     //
     SparseBitSet live(maxId);
 
+    // BBs to rescan for interference. All of them unless edges from the
+    // previous GRF RA iteration can be reused (-incrementalIntf).
+    std::vector<bool> dirtyBBs(kernel.fg.getNumBB(), true);
+    if (canUseIntfSnapshot())
+    {
+        restoreIntfSnapshot(dirtyBBs);
+    }
+
     buildInterferenceAmongLiveOuts();
 
     for (G4_BB *bb : kernel.fg)
@@ -2683,18 +2861,39 @@ void Interference::computeInterference()
         //
         live.clear();
         //
+        // clean BBs are still traversed to update ref counts and
+        // other live range properties, but no edges are added
+        //
+        replayOnly = !dirtyBBs[bb->getId()];
+        //
         // start with all live ranges that are live at the exit of BB
         //
-        buildInterferenceAtBBExit(bb, live);
+        if (!replayOnly)
+        {
+            buildInterferenceAtBBExit(bb, live);
+        }
         //
         // traverse inst in the reverse order
         //
 
         buildInterferenceWithinBB(bb, live);
     }
+    replayOnly = false;
 
     buildInterferenceAmongLiveIns();
 
+    if (gra.intfSnapshot && liveAnalysis->livenessClass(G4_GRF))
+    {
+        if (splitNum == 0)
+        {
+            saveIntfSnapshot();
+        }
+        else
+        {
+            gra.intfSnapshot->valid = false;
+        }
+    }
+
     //
     // Build interference with physical registers assigned by local RA
     //
@@ -10464,9 +10663,40 @@ int GlobalRA::coloringRegAlloc()
             builder.phyregpool.getGreg(0), 0);
     }
     bool rematDone = false, alignedScalarSplitDone = false;
+    // RA iteration remat last ran in, see -rematEveryIter below
+    unsigned rematIterationNo = UINT_MAX;
     bool reserveSpillReg = false;
     VarSplit splitPass(*this);
 
+    // Carry interference of BBs untouched by spill code over to the next
+    // iteration. Stack calls, address taken variables and debug info intervals
+    // need more than the per-BB edges, so they always get a full rebuild.
+    if (builder.getOption(vISA_IncrementalIntf) && !hasStackCall &&
+        !kernel.getHasAddrTaken() && !builder.getOption(vISA_GenerateDebugInfo))
+    {
+        intfSnapshot.reset(new IntfSnapshot());
+    }
+
+    // Likewise reuse gen/kill sets of unchanged BBs in liveness.
+    if (builder.getOption(vISA_IncrementalLiveness) && !hasStackCall &&
+        !kernel.getHasAddrTaken())
+    {
+        livenessSnapshot.reset(new LivenessSnapshot());
+    }
+
+    // Let remat run after every failed coloring instead of only once, within
+    // a budget of -rematEffort queries per instruction over all iterations.
+    if (builder.getOption(vISA_RematEveryIter))
+    {
+        unsigned int numInsts = 0;
+        for (auto bb : kernel.fg)
+        {
+            numInsts += (unsigned int)bb->size();
+        }
+        rematCache.reset(new RematCache());
+        rematCache->budget = builder.getOptions()->getuInt32Option(vISA_RematEffort) * numInsts;
+    }
+
     while (iterationNo < maxRAIterations)
     {
         if (builder.getOption(vISA_RATrace))
@@ -10545,7 +10775,7 @@ int GlobalRA::coloringRegAlloc()
         }
 
         LivenessAnalysis liveAnalysis(*this, G4_GRF | G4_INPUT);
-        liveAnalysis.computeLiveness();
+        liveAnalysis.computeLiveness(livenessSnapshot.get());
         if (builder.getOption(vISA_dumpLiveness))
         {
             liveAnalysis.dump();
@@ -10597,7 +10827,11 @@ int GlobalRA::coloringRegAlloc()
                 bool rerunGRA = false;
                 bool globalSplitChange = false;
 
-                if (!rematDone &&
+                // With -rematEveryIter remat runs at most once per RA
+                // iteration, so its recoloring below cannot repeat for
+                // every candidate it finds.
+                if ((!rematDone ||
+                     (rematCache && rematCache->hasBudget() && rematIterationNo != iterationNo)) &&
                     rematOn)
                 {
                     if (builder.getOption(vISA_RATrace))
@@ -10607,6 +10841,7 @@ int GlobalRA::coloringRegAlloc()
                     Rematerialization remat(kernel, liveAnalysis, coloring, rpe, *this);
                     remat.run();
                     rematDone = true;
+                    rematIterationNo = iterationNo;
 
                     // Re-run GRA loop only if remat caused changes to IR
                     rerunGRA |= remat.getChangesMade();
@@ -10654,7 +10889,9 @@ int GlobalRA::coloringRegAlloc()
                     globalSplitChange = true;
                 }
 
-                if (iterationNo == 0 &&
+                // With -rematEveryIter, remat changes of later iterations
+                // also need fresh coloring before spill code is inserted.
+                if ((iterationNo == 0 || rematCache) &&
                     (rerunGRA || globalSplitChange || kernel.getOption(vISA_forceBCR)))
                 {
                     if (kernel.getOption(vISA_forceBCR))
@@ -10785,8 +11022,19 @@ int GlobalRA::coloringRegAlloc()
 
                 if (!reserveSpillReg && !disableSpillCoalecse && builder.useSends())
                 {
+                    auto beforeCleanup = getScratchTraffic();
                     CoalesceSpillFills c(kernel, liveAnalysis, coloring, spillGRF, iterationNo, rpe, *this);
                     c.run();
+                    auto afterCleanup = getScratchTraffic();
+                    scratchBytesRemovedByCleanup += (int)beforeCleanup.bytes - (int)afterCleanup.bytes;
+                    scratchMsgsRemovedByCleanup += (int)beforeCleanup.messages - (int)afterCleanup.messages;
+
+                    if (builder.getOption(vISA_RATrace))
+                    {
+                        std::cout << "\t--scratch bytes before/after spill cleanup: " << beforeCleanup.bytes
+                            << "/" << afterCleanup.bytes << " (" << beforeCleanup.messages << "/"
+                            << afterCleanup.messages << " messages)\n";
+                    }
                 }
 
                 if (iterationNo == FAIL_SAFE_RA_LIMIT)
@@ -10822,6 +11070,15 @@ int GlobalRA::coloringRegAlloc()
                     regChart->dumpRegChart(std::cerr);
                 }
 
+                scratchTraffic = getScratchTraffic();
+                if (builder.getOption(vISA_RATrace) && scratchTraffic.bytes)
+                {
+                    std::cout << "\t--scratch bytes moved: " << scratchTraffic.bytes << " in "
+                        << scratchTraffic.messages << " messages, "
+                        << (int)scratchTraffic.bytes + scratchBytesRemovedByCleanup << " in "
+                        << (int)scratchTraffic.messages + scratchMsgsRemovedByCleanup
+                        << " messages without spill cleanup\n";
+                }
                 expandSpillFillIntrinsics(nextSpillOffset);
 
                 if (builder.getOption(vISA_OptReport))
@@ -10865,6 +11122,9 @@ int GlobalRA::coloringRegAlloc()
             break;
         }
     }
+    intfSnapshot.reset();
+    rematCache.reset();
+    livenessSnapshot.reset();
     assignRegForAliasDcl();
     computePhyReg();
 
@@ -10951,6 +11211,9 @@ int GlobalRA::coloringRegAlloc()
             }
         }
         jitInfo->numGRFSpillFill = GRFSpillFillCount;
+        jitInfo->numScratchBytesMoved = scratchTraffic.bytes;
+        jitInfo->numScratchBytesMovedBeforeCleanup =
+            (unsigned)((int)scratchTraffic.bytes + scratchBytesRemovedByCleanup);
     }
 
     if (builder.getOption(vISA_LocalDeclareSplitInGlobalRA))
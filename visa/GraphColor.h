@@ -329,6 +329,53 @@ namespace vISA
         void augmentIntfGraph();
     };
 
+    // Liveness driven interference edges of the previous GRF RA iteration.
+    // Edges are recorded by declare since variable ids are reassigned in
+    // every iteration. With -incrementalIntf, only BBs whose instructions or
+    // live-out set changed since the snapshot (typically due to spill/fill
+    // insertion) are rescanned; edges of the remaining BBs are carried over.
+    struct IntfSnapshot
+    {
+        std::vector<std::pair<G4_Declare*, G4_Declare*>> edges;
+        // Indexed by BB id: hash of the BB's instructions/operands and the
+        // sorted list of variables live at BB exit.
+        std::vector<uint64_t> bbSignature;
+        std::vector<std::vector<G4_Declare*>> bbLiveOut;
+        bool valid = false;
+    };
+
+    // Rematerialization state kept across GRF RA iterations with
+    // -rematEveryIter. References found in a BB are recorded by declare with
+    // lexical ids relative to the BB start, so they stay valid while spill
+    // code is inserted elsewhere; only BBs whose signature changed are
+    // rescanned. Def instructions failing checks that depend on nothing but
+    // the instruction itself are remembered as well. Remat queries of all
+    // iterations together are bounded by budget.
+    struct RematCache
+    {
+        static const unsigned int NO_USE = std::numeric_limits<unsigned int>::max();
+
+        struct DclRefs
+        {
+            G4_Declare* dcl = nullptr;
+            std::vector<G4_INST*> def;
+            unsigned int numUses = 0;
+            // Offset of the last use from the start of the BB, NO_USE if
+            // the BB has no use of dcl.
+            unsigned int lastUseOffset = NO_USE;
+            std::vector<unsigned int> rowsUsed;
+        };
+
+        // Indexed by BB id.
+        std::vector<uint64_t> bbSignature;
+        std::vector<std::vector<DclRefs>> bbRefs;
+        std::unordered_set<G4_INST*> rejectedDefs;
+        unsigned int budget = 0;
+        unsigned int numQueries = 0;
+
+        bool hasBudget() const { return numQueries < budget; }
+    };
+
     class Interference
     {
         friend class Augmentation;
@@ -440,7 +487,18 @@ namespace vISA
 
         void generateSparseIntfGraph();
 
+        // Set while rescanning a BB only for its live range side effects
+        // (ref counts, infinite spill cost, forbidden regs); no edges are added.
+        bool replayOnly = false;
+
+        void getLiveOutDcls(const G4_BB* bb, std::vector<G4_Declare*>& dcls) const;
+        bool canUseIntfSnapshot() const;
+        void restoreIntfSnapshot(std::vector<bool>& dirtyBBs);
+        void saveIntfSnapshot();
+
     public:
+        static uint64_t computeBBSignature(G4_BB* bb);
+
         Interference(const LivenessAnalysis* l, LiveRange** const & lr, unsigned n, unsigned ns, unsigned nm,
             GlobalRA& g);
 
@@ -488,6 +546,11 @@ namespace vISA
 
         void checkAndSetIntf(unsigned v1, unsigned v2)
         {
+            if (replayOnly)
+            {
+                return;
+            }
+
             if (v1 < v2)
             {
                 safeSetInterference(v1, v2);
@@ -707,6 +770,25 @@ namespace vISA
         std::unique_ptr<VerifyAugmentation> verifyAugmentation;
         std::unique_ptr<RegChartDump> regChart;
         std::unique_ptr<SpillAnalysis> spillAnalysis;
+        // Non-null only during GRF coloring iterations with -incrementalIntf.
+        std::unique_ptr<IntfSnapshot> intfSnapshot;
+        // Non-null only during GRF coloring iterations with -rematEveryIter.
+        std::unique_ptr<RematCache> rematCache;
+        // Non-null only during GRF coloring iterations with -incrementalLiveness.
+        std::unique_ptr<LivenessSnapshot> livenessSnapshot;
+
+        // Static traffic of the spill/fill intrinsics in the kernel.
+        struct ScratchTraffic
+        {
+            unsigned bytes = 0;
+            unsigned messages = 0;
+        };
+        ScratchTraffic getScratchTraffic() const;
+        // Traffic of the allocated kernel, and traffic removed by spill
+        // cleanup over all GRF coloring iterations (negative if it grew).
+        ScratchTraffic scratchTraffic;
+        int scratchBytesRemovedByCleanup = 0;
+        int scratchMsgsRemovedByCleanup = 0;
         static bool useGenericAugAlign(PlatformGen gen)
         {
             if (gen == PlatformGen::GEN9 ||
@@ -791,7 +873,7 @@ namespace vISA
         uint32_t numGRFSpill = 0;
         uint32_t numGRFFill = 0;
 
-        bool spillFillIntrinUsesLSC(G4_INST* spillFillIntrin);
+        bool spillFillIntrinUsesLSC(G4_INST* spillFillIntrin) const;
         void expandFillLSC(G4_BB* bb, INST_LIST_ITER& instIt);
         void expandSpillLSC(G4_BB* bb, INST_LIST_ITER& instIt);
         void expandFillNonStackcall(uint32_t numRows, uint32_t offset, short rowOffset, G4_SrcRegRegion* header, G4_DstRegRegion* resultRgn, G4_BB* bb, INST_LIST_ITER& instIt);
@@ -878,6 +960,8 @@ namespace vISA
         static unsigned GRFToHwordSize(unsigned numGRFs, const IR_Builder& builder);
         static unsigned GRFSizeToOwords(unsigned numGRFs, const IR_Builder& builder);
         static unsigned getHWordByteSize();
+        // Largest payload of one scratch block message in GRFs.
+        static unsigned getMaxScratchBlockGRFs(const IR_Builder& builder);
 
         // RA specific fields
         G4_Declare* getGRFDclForHRA(int GRFNum) const { return GRFDclsForHRA[GRFNum]; }
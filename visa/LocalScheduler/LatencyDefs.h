@@ -0,0 +1,57 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2021 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// Tunable parameters of LatencyTable. ENUM is also the key used in a
+// -latencyTable file; MIN is the smallest value such a file may set.
+//
+//          ENUM                 DEFAULT                                   MIN
+// Pre-Xe latencies.
+DEF_LATENCY(LEGACY_PIPELINE,     LegacyLatencies::IVB_PIPELINE_LENGTH,     0)
+DEF_LATENCY(LEGACY_MATH,         LegacyLatencies::EDGE_LATENCY_MATH,       0)
+DEF_LATENCY(LEGACY_MATH_TYPE2,   LegacyLatencies::EDGE_LATENCY_MATH_TYPE2, 0)
+// Pre-Xe message latencies, indexed by SFID (must stay in this order).
+DEF_LATENCY(LEGACY_FF_NULL,      LegacyFFLatency[0],                       0)
+DEF_LATENCY(LEGACY_FF_RESERVED,  LegacyFFLatency[1],                       0)
+DEF_LATENCY(LEGACY_FF_SAMPLER,   LegacyFFLatency[2],                       0)
+DEF_LATENCY(LEGACY_FF_GATEWAY,   LegacyFFLatency[3],                       0)
+DEF_LATENCY(LEGACY_FF_DP_READ,   LegacyFFLatency[4],                       0)
+DEF_LATENCY(LEGACY_FF_DP_WRITE,  LegacyFFLatency[5],                       0)
+DEF_LATENCY(LEGACY_FF_URB,       LegacyFFLatency[6],                       0)
+DEF_LATENCY(LEGACY_FF_SPAWNER,   LegacyFFLatency[7],                       0)
+DEF_LATENCY(LEGACY_FF_VME,       LegacyFFLatency[8],                       0)
+DEF_LATENCY(LEGACY_FF_DP_CC,     LegacyFFLatency[9],                       0)
+DEF_LATENCY(LEGACY_FF_DP_DC,     LegacyFFLatency[10],                      0)
+DEF_LATENCY(LEGACY_FF_DP_PI,     LegacyFFLatency[11],                      0)
+DEF_LATENCY(LEGACY_FF_DP_DC1,    LegacyFFLatency[12],                      0)
+DEF_LATENCY(LEGACY_FF_CRE,       LegacyFFLatency[13],                      0)
+DEF_LATENCY(LEGACY_FF_UNKNOWN,   LegacyFFLatency[14],                      0)
+// Xe+ latencies.
+DEF_LATENCY(FPU_ACC,             LatenciesXe::FPU_ACC,                     0)
+DEF_LATENCY(FPU,                 LatenciesXe::FPU,                         0)
+DEF_LATENCY(MATH,                LatenciesXe::MATH,                        0)
+DEF_LATENCY(BRANCH,              LatenciesXe::BRANCH,                      0)
+DEF_LATENCY(BARRIER,             LatenciesXe::BARRIER,                     0)
+DEF_LATENCY(DELTA,               LatenciesXe::DELTA,                       0)
+DEF_LATENCY(DELTA_MATH,          LatenciesXe::DELTA_MATH,                  0)
+DEF_LATENCY(ARF,                 LatenciesXe::ARF,                         0)
+// Setting DPAS replaces the platform specific dpas latencies.
+DEF_LATENCY(DPAS,                LatenciesXe::DPAS,                        1)
+DEF_LATENCY(SLM,                 LatenciesXe::SLM,                         0)
+DEF_LATENCY(SEND_OTHERS,         LatenciesXe::SEND_OTHERS,                 0)
+DEF_LATENCY(DP_L3,               LatenciesXe::DP_L3,                       0)
+DEF_LATENCY(SAMPLER_L3,          LatenciesXe::SAMPLER_L3,                  0)
+DEF_LATENCY(SLM_FENCE,           LatenciesXe::SLM_FENCE,                   0)
+DEF_LATENCY(LSC_UNTYPED_L1,      LatenciesXe::LSC_UNTYPED_L1,              0)
+DEF_LATENCY(LSC_UNTYPED_L3,      LatenciesXe::LSC_UNTYPED_L3,              0)
+DEF_LATENCY(LSC_UNTYPED_FENCE,   LatenciesXe::LSC_UNTYPED_FENCE,           0)
+DEF_LATENCY(LSC_TYPED_L1,        LatenciesXe::LSC_TYPED_L1,                0)
+DEF_LATENCY(LSC_TYPED_L3,        LatenciesXe::LSC_TYPED_L3,                0)
+DEF_LATENCY(LSC_TYPED_FENCE,     LatenciesXe::LSC_TYPED_FENCE,             0)
+// Xe+ pipeline occupancy of a SIMD8 instruction.
+DEF_LATENCY(OC_MATH,             4,                                        1)
+DEF_LATENCY(OC_OTHERS,           1,                                        1)
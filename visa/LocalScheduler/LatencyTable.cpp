@@ -10,8 +10,245 @@ SPDX-License-Identifier: MIT
 #include "LocalScheduler_G4IR.h"
 #include "../G4_IR.hpp"
 
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
 using namespace vISA;
 
+namespace
+{
+    const char* const LatencyParamNames[] = {
+#define DEF_LATENCY(ENUM, DEFAULT, MIN) #ENUM,
+#include "LatencyDefs.h"
+#undef DEF_LATENCY
+    };
+
+    const uint16_t LatencyParamMins[] = {
+#define DEF_LATENCY(ENUM, DEFAULT, MIN) MIN,
+#include "LatencyDefs.h"
+#undef DEF_LATENCY
+    };
+
+    constexpr unsigned NUM_LATENCY_PARAMS = static_cast<unsigned>(LatencyParam::NUM_PARAMS);
+
+    static_assert(static_cast<unsigned>(LatencyParam::LEGACY_FF_UNKNOWN) -
+        static_cast<unsigned>(LatencyParam::LEGACY_FF_NULL) + 1 ==
+        sizeof(LegacyFFLatency) / sizeof(LegacyFFLatency[0]),
+        "one LEGACY_FF parameter per LegacyFFLatency entry");
+
+    struct LatencyOverrides
+    {
+        std::array<uint16_t, NUM_LATENCY_PARAMS> values {};
+        std::bitset<NUM_LATENCY_PARAMS> isSet;
+    };
+
+    // A latency table file is a JSON object mapping parameter names to
+    // values, e.g. { "FPU": 12, "LSC_UNTYPED_L1": 40 }. Parameters that are
+    // not listed keep their built-in value.
+    bool parseLatencyTable(const std::string& text, LatencyOverrides& result, std::string& error)
+    {
+        size_t pos = 0;
+        unsigned line = 1;
+        auto fail = [&](const std::string& msg)
+        {
+            error = "line " + std::to_string(line) + ": " + msg;
+            return false;
+        };
+        auto skipSpace = [&]()
+        {
+            for (; pos < text.size() && isspace((unsigned char)text[pos]); ++pos)
+            {
+                if (text[pos] == '\n')
+                {
+                    ++line;
+                }
+            }
+        };
+        auto accept = [&](char c)
+        {
+            skipSpace();
+            if (pos < text.size() && text[pos] == c)
+            {
+                ++pos;
+                return true;
+            }
+            return false;
+        };
+
+        if (!accept('{'))
+        {
+            return fail("expected '{'");
+        }
+        if (!accept('}'))
+        {
+            do
+            {
+                if (!accept('"'))
+                {
+                    return fail("expected a parameter name");
+                }
+                size_t nameEnd = text.find('"', pos);
+                if (nameEnd == std::string::npos)
+                {
+                    return fail("unterminated parameter name");
+                }
+                std::string name = text.substr(pos, nameEnd - pos);
+                pos = nameEnd + 1;
+
+                unsigned id = 0;
+                while (id < NUM_LATENCY_PARAMS && name != LatencyParamNames[id])
+                {
+                    ++id;
+                }
+                if (id == NUM_LATENCY_PARAMS)
+                {
+                    return fail("unknown parameter \"" + name + "\"");
+                }
+                if (result.isSet[id])
+                {
+                    return fail("parameter \"" + name + "\" is set twice");
+                }
+                if (!accept(':'))
+                {
+                    return fail("expected ':' after \"" + name + "\"");
+                }
+
+                skipSpace();
+                size_t digitsStart = pos;
+                uint32_t value = 0;
+                for (; pos < text.size() && isdigit((unsigned char)text[pos]); ++pos)
+                {
+                    value = value * 10 + (text[pos] - '0');
+                    if (value > UINT16_MAX)
+                    {
+                        return fail("value of \"" + name + "\" is out of range");
+                    }
+                }
+                if (pos == digitsStart)
+                {
+                    return fail("expected a non-negative integer value for \"" + name + "\"");
+                }
+                if (value < LatencyParamMins[id])
+                {
+                    return fail("\"" + name + "\" must be at least " +
+                        std::to_string(LatencyParamMins[id]));
+                }
+                result.values[id] = (uint16_t)value;
+                result.isSet[id] = true;
+            } while (accept(','));
+
+            if (!accept('}'))
+            {
+                return fail("expected ',' or '}'");
+            }
+        }
+        skipSpace();
+        if (pos != text.size())
+        {
+            return fail("unexpected text after '}'");
+        }
+        return true;
+    }
+
+    // Each file is read once per process, so that a bad file is reported once
+    // and not for every scheduler run.
+    const LatencyOverrides& getLatencyOverrides(const char* fileName)
+    {
+        static std::mutex cacheMutex;
+        static std::map<std::string, LatencyOverrides> cache;
+
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(fileName);
+        if (it != cache.end())
+        {
+            return it->second;
+        }
+
+        LatencyOverrides& overrides = cache[fileName];
+        std::string error;
+        std::ifstream ifs(fileName);
+        if (!ifs)
+        {
+            error = "cannot open the file";
+        }
+        else
+        {
+            std::stringstream text;
+            text << ifs.rdbuf();
+            if (!parseLatencyTable(text.str(), overrides, error))
+            {
+                overrides = LatencyOverrides();
+            }
+        }
+        if (!error.empty())
+        {
+            std::cerr << "warning: latency table " << fileName << ": " << error
+                << ", using the built-in latencies\n";
+        }
+        return overrides;
+    }
+} // namespace
+
+LatencyTable::LatencyTable(const IR_Builder* builder)
+    : m_builder(builder)
+    , m_params {{
+#define DEF_LATENCY(ENUM, DEFAULT, MIN) uint16_t(DEFAULT),
+#include "LatencyDefs.h"
+#undef DEF_LATENCY
+    }}
+{
+    if (const char* fileName = builder->getOptions()->getOptionCstr(vISA_LatencyTableFile))
+    {
+        const LatencyOverrides& overrides = getLatencyOverrides(fileName);
+        for (unsigned i = 0; i < NUM_PARAMS; ++i)
+        {
+            if (overrides.isSet[i])
+            {
+                m_params[i] = overrides.values[i];
+            }
+        }
+        m_overridden = overrides.isSet;
+    }
+}
+
+bool LatencyTable::isPlatformSpecific(LatencyParam P) const
+{
+    if (P != LatencyParam::DPAS || isOverridden(P))
+    {
+        return false;
+    }
+    // See getDPAS8x8Latency() and the dpas case of getLatencyG12().
+    switch (m_builder->getPlatform())
+    {
+    case Xe_XeHPSDV:
+    case Xe_PVC:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void LatencyTable::dump(std::ostream& os) const
+{
+    os << "{";
+    const char* sep = "\n";
+    for (unsigned i = 0; i < NUM_PARAMS; ++i)
+    {
+        if (isPlatformSpecific(static_cast<LatencyParam>(i)))
+        {
+            continue;
+        }
+        os << sep << "  \"" << LatencyParamNames[i] << "\": " << m_params[i];
+        sep = ",\n";
+    }
+    os << "\n}\n";
+}
+
 uint16_t LatencyTable::getLatency(G4_INST* Inst) const
 {
     auto GEN = m_builder->getPlatformGeneration();
@@ -23,6 +260,10 @@ uint16_t LatencyTable::getLatency(G4_INST* Inst) const
 
 uint16_t LatencyTable::getDPAS8x8Latency() const
 {
+    if (isOverridden(LatencyParam::DPAS))
+    {
+        return uint16_t(get(LatencyParam::DPAS) + 7);
+    }
     switch(m_builder->getPlatform())
     {
         case Xe_XeHPSDV:
@@ -53,14 +294,18 @@ uint16_t LatencyTable::getLatencyLegacy(G4_INST* Inst) const
     if (Inst->isSend())
     {
         G4_SendDesc* MsgDesc = Inst->getMsgDesc();
-        return LegacyFFLatency[SFIDtoInt(MsgDesc->getSFID())];
+        // SFIDs past the legacy ones use the latency of unknown messages.
+        const unsigned FirstFF = static_cast<unsigned>(LatencyParam::LEGACY_FF_NULL);
+        const unsigned LastFF = static_cast<unsigned>(LatencyParam::LEGACY_FF_UNKNOWN);
+        unsigned FF = std::min(FirstFF + SFIDtoInt(MsgDesc->getSFID()), LastFF);
+        return get(static_cast<LatencyParam>(FF));
     } else if (Inst->isMath()) {
         if (Inst->asMathInst()->getMathCtrl() == MATH_FDIV ||
             Inst->asMathInst()->getMathCtrl() == MATH_POW)
-            return LegacyLatencies::EDGE_LATENCY_MATH_TYPE2;
-        return LegacyLatencies::EDGE_LATENCY_MATH;
+            return get(LatencyParam::LEGACY_MATH_TYPE2);
+        return get(LatencyParam::LEGACY_MATH);
     }
-    return LegacyLatencies::IVB_PIPELINE_LENGTH;
+    return get(LatencyParam::LEGACY_PIPELINE);
 }
 
 uint16_t LatencyTable::getOccupancyLegacy(G4_INST* Inst) const
@@ -141,7 +386,7 @@ uint16_t LatencyTable::getLatencyG12(const G4_INST* Inst) const
             if (MsgDesc->isFence())
             {
                 return MsgDesc->isTyped() ?
-                    LatenciesXe::LSC_TYPED_FENCE : LatenciesXe::LSC_UNTYPED_FENCE;
+                    get(LatencyParam::LSC_TYPED_FENCE) : get(LatencyParam::LSC_UNTYPED_FENCE);
             }
             else
             {
@@ -149,94 +394,83 @@ uint16_t LatencyTable::getLatencyG12(const G4_INST* Inst) const
                     (MsgDesc->getCachingL1() != Caching::UC && m_builder->getOption(vISA_assumeL1Hit));
                 if (MsgDesc->isLSC() && MsgDesc->isTyped())
                 {
-                    return isCachedInL1 ? LatenciesXe::LSC_TYPED_L1 : LatenciesXe::LSC_TYPED_L3;
+                    return isCachedInL1 ? get(LatencyParam::LSC_TYPED_L1) : get(LatencyParam::LSC_TYPED_L3);
                 }
                 else
                 {
-                    return isCachedInL1 ? LatenciesXe::LSC_UNTYPED_L1 : LatenciesXe::LSC_UNTYPED_L3;
+                    return isCachedInL1 ? get(LatencyParam::LSC_UNTYPED_L1) : get(LatencyParam::LSC_UNTYPED_L3);
                 }
             }
         }
         if (MsgDesc->isSLM())
-            return Inst->asSendInst()->isFence() ? LatenciesXe::SLM_FENCE : LatenciesXe::SLM;
+            return Inst->asSendInst()->isFence() ? get(LatencyParam::SLM_FENCE) : get(LatencyParam::SLM);
         if (MsgDesc->isSampler())
-            return LatenciesXe::SAMPLER_L3;
+            return get(LatencyParam::SAMPLER_L3);
         if (MsgDesc->isHDC())
-            return LatenciesXe::DP_L3;
+            return get(LatencyParam::DP_L3);
         if (MsgDesc->isBarrier())
-            return LatenciesXe::BARRIER;
-         return LatenciesXe::SEND_OTHERS;
+            return get(LatencyParam::BARRIER);
+         return get(LatencyParam::SEND_OTHERS);
     }
     if (Inst->isMath())
     {
-        return uint16_t(LatenciesXe::MATH + LatenciesXe::DELTA_MATH * Scale);
+        return uint16_t(get(LatencyParam::MATH) + get(LatencyParam::DELTA_MATH) * Scale);
     }
     if (Inst->isFlowControl())
     {
-        return LatenciesXe::BRANCH;
+        return get(LatencyParam::BRANCH);
     }
     if (Inst->isDpas()) {
-
-        if (m_builder->getPlatform() == Xe_PVC)
-        {
-            G4_InstDpas *dpas = Inst->asDpasInst();
-            return uint16_t(LatenciesXe::DPAS + dpas->getRepeatCount() - 1);
-        }
-
-        if (m_builder->getPlatform() == Xe_PVCXT)
+        G4_InstDpas* dpas = Inst->asDpasInst();
+        if (!isOverridden(LatencyParam::DPAS))
         {
-            G4_InstDpas *dpas = Inst->asDpasInst();
-            return uint16_t(LatenciesXe::DPAS + 1 + dpas->getRepeatCount() - 1); //22 ~29
-        }
+            if (m_builder->getPlatform() == Xe_PVCXT)
+            {
+                return uint16_t(get(LatencyParam::DPAS) + 1 + dpas->getRepeatCount() - 1); //22 ~29
+            }
 
-        if (m_builder->getPlatform() == Xe_DG2)
-        {
-            G4_InstDpas *dpas = Inst->asDpasInst();
-            switch(dpas->getRepeatCount())
+            if (m_builder->getPlatform() == Xe_DG2)
             {
-            case 1:
-                return 21;
-            case 2:
-                return 22;
-            case 8:
-                return 32;
-            default:
-                return 32;
+                switch(dpas->getRepeatCount())
+                {
+                case 1:
+                    return 21;
+                case 2:
+                    return 22;
+                case 8:
+                    return 32;
+                default:
+                    return 32;
+                }
             }
         }
-        G4_InstDpas* dpas = Inst->asDpasInst();
-        return uint16_t(LatenciesXe::DPAS + dpas->getRepeatCount() - 1);
+        return uint16_t(get(LatencyParam::DPAS) + dpas->getRepeatCount() - 1);
     }
     if (Inst->writesFlag() || (Dst && Dst->isA0()))
     {
-        return LatenciesXe::ARF;
+        return get(LatencyParam::ARF);
     }
     if (Inst->isArithmetic()) {
         if (Dst->isAccReg())
-            return uint16_t(LatenciesXe::FPU_ACC + LatenciesXe::DELTA * Scale);
-        return uint16_t(LatenciesXe::FPU + LatenciesXe::DELTA * Scale);
+            return uint16_t(get(LatencyParam::FPU_ACC) + get(LatencyParam::DELTA) * Scale);
+        return uint16_t(get(LatencyParam::FPU) + get(LatencyParam::DELTA) * Scale);
     }
 
     // By default, use the FPU pipeline latency.
-    return uint16_t(LatenciesXe::FPU);
+    return get(LatencyParam::FPU);
 }
 
 uint16_t LatencyTable::getOccupancyG12(G4_INST* Inst) const
 {
-    enum OccupancyXe {
-        G12_OC_MATH = 4,
-        G12_OC_Others = 1
-    };
-
     int Sz = Inst->getExecSize();
     int Scale = (Sz <= 8) ? 1 : (Sz == 16) ? 2 : 4;
     if (Inst->isMath())
-        return uint16_t(G12_OC_MATH * Scale);
+        return uint16_t(get(LatencyParam::OC_MATH) * Scale);
     if (Inst->isFastHFInstruction())
         Scale = (Sz <= 16) ? 1 : 2;
     else if (G4_DstRegRegion* Dst = Inst->getDst()) {
         if (Dst->getTypeSize() == 8)
             Scale = (Sz <= 4) ? 1 : 2;
     }
-    return uint16_t(G12_OC_Others * Scale);
+    return uint16_t(get(LatencyParam::OC_OTHERS) * Scale);
 }
@@ -11,6 +11,10 @@ SPDX-License-Identifier: MIT
 
 #include "../BuildIR.h"
 
+#include <array>
+#include <bitset>
+#include <ostream>
+
 namespace vISA
 {
 
@@ -89,19 +93,39 @@ namespace vISA
     };
 
 
+    enum class LatencyParam : unsigned
+    {
+#define DEF_LATENCY(ENUM, DEFAULT, MIN) ENUM,
+#include "LatencyDefs.h"
+#undef DEF_LATENCY
+        NUM_PARAMS
+    };
+
     class LatencyTable
     {
     public:
-        explicit LatencyTable(const IR_Builder* builder)
-            : m_builder(builder)
-        {
-        }
+        // Uses the built-in latencies, overridden by the ones set in the
+        // -latencyTable file if there is one.
+        explicit LatencyTable(const IR_Builder* builder);
         // Functions to get latencies/occupancy based on platforms
         uint16_t getOccupancy(G4_INST* Inst) const;
         uint16_t getLatency(G4_INST* Inst) const;
         uint16_t getDPAS8x8Latency() const;
 
+        // Writes the active parameters in the -latencyTable file format.
+        // Parameters whose latencies the platform computes itself are left
+        // out unless overridden, so loading an unedited dump changes nothing.
+        void dump(std::ostream& os) const;
+
     private:
+        static constexpr unsigned NUM_PARAMS = static_cast<unsigned>(LatencyParam::NUM_PARAMS);
+
+        uint16_t get(LatencyParam P) const { return m_params[static_cast<unsigned>(P)]; }
+        bool isOverridden(LatencyParam P) const { return m_overridden[static_cast<unsigned>(P)]; }
+        // True if the latencies of P come from platform specific code rather
+        // than from its value in the table.
+        bool isPlatformSpecific(LatencyParam P) const;
+
         uint16_t getLatencyLegacy(G4_INST* Inst) const;
         uint16_t getOccupancyLegacy(G4_INST* Inst) const;
 
@@ -110,6 +134,9 @@ namespace vISA
         uint16_t getOccupancyG12(G4_INST* Inst) const;
 
         const IR_Builder* m_builder;
+        std::array<uint16_t, NUM_PARAMS> m_params;
+        // Parameters set by the -latencyTable file.
+        std::bitset<NUM_PARAMS> m_overridden;
     };
 
 } // namespace vISA
@@ -12,10 +12,12 @@ SPDX-License-Identifier: MIT
 #include "../Timer.h"
 #include "visa_wa.h"
 
+#include <atomic>
 #include <fstream>
 #include <functional>
 #include <sstream>
 #include <queue>
+#include <thread>
 
 using namespace vISA;
 
@@ -29,39 +31,55 @@ void LocalScheduler::localScheduling()
     }
 
     DEBUG_VERBOSE("[Scheduling]: Starting...");
-    BB_LIST_ITER ib(fg.begin()), bend(fg.end());
-    MUST_BE_TRUE(ib != bend, ERROR_SCHEDULER);
+    MUST_BE_TRUE(fg.begin() != fg.end(), ERROR_SCHEDULER);
 
     VISA_BB_INFO* bbInfo = (VISA_BB_INFO *)mem.alloc(fg.size() * sizeof(VISA_BB_INFO));
     memset(bbInfo, 0, fg.size() * sizeof(VISA_BB_INFO));
-    int i = 0;
 
     const Options *m_options = fg.builder->getOptions();
     LatencyTable LT(fg.builder);
+    if (m_options->getOption(vISA_DumpLatencyTable))
+    {
+        const char *asmName = nullptr;
+        m_options->getOption(VISA_AsmFileName, asmName);
+        std::string dumpName = asmName != nullptr ? asmName : "kernel";
+        std::ofstream ofile(dumpName + ".latency.json", std::ios::out);
+        LT.dump(ofile);
+    }
 
     PointsToAnalysis p(fg.getKernel()->Declares, fg.size());
     p.doPointsToAnalysis(fg);
 
-    uint32_t totalCycles = 0;
+    // Blocks to schedule, bbInfo is indexed by the position in this list.
+    std::vector<G4_BB*> blocks;
     uint32_t scheduleStartBBId = m_options->getuInt32Option(vISA_LocalSchedulingStartBB);
     uint32_t shceduleEndBBId = m_options->getuInt32Option(vISA_LocalSchedulingEndBB);
-    for (; ib != bend; ++ib)
+    for (G4_BB* bb : fg)
     {
-        if ((*ib)->getId() < scheduleStartBBId || (*ib)->getId() > shceduleEndBBId)
+        if (bb->getId() < scheduleStartBBId || bb->getId() > shceduleEndBBId)
         {
             continue;
         }
 
-        unsigned instCountBefore = (uint32_t)(*ib)->size();
         #define SCH_THRESHOLD 2
-        if (instCountBefore < SCH_THRESHOLD)
+        if (bb->size() < SCH_THRESHOLD)
         {
             continue;
         }
+        blocks.push_back(bb);
+    }
+
+    unsigned schedulerWindowSize = m_options->getuInt32Option(vISA_SchedulerWindowSize);
+    auto needsWindows = [schedulerWindowSize](G4_BB* bb)
+    {
+        return schedulerWindowSize > 0 && bb->size() > schedulerWindowSize;
+    };
 
+    auto scheduleBlock = [&](size_t i)
+    {
+        G4_BB* bb = blocks[i];
         Mem_Manager bbMem(4096);
-        unsigned schedulerWindowSize = m_options->getuInt32Option(vISA_SchedulerWindowSize);
-        if (schedulerWindowSize > 0 && instCountBefore > schedulerWindowSize)
+        if (needsWindows(bb))
         {
             // If BB has a lot of instructions then when recursively
             // traversing DAG in list scheduler, stack overflow occurs.
@@ -70,48 +88,103 @@ void LocalScheduler::localScheduling()
             unsigned int count = 0;
             std::vector<G4_BB*> sections;
 
-            for (INST_LIST_ITER inst_it = (*ib)->begin();
+            for (INST_LIST_ITER inst_it = bb->begin();
                 ;
                 inst_it++)
             {
                 if (count == schedulerWindowSize ||
-                    inst_it == (*ib)->end())
+                    inst_it == bb->end())
                 {
                     G4_BB* tempBB = fg.createNewBB(false);
                     sections.push_back(tempBB);
                     tempBB->splice(tempBB->begin(),
-                        (*ib), (*ib)->begin(), inst_it);
+                        bb, bb->begin(), inst_it);
                     G4_BB_Schedule schedule(fg.getKernel(), bbMem, tempBB, LT, p);
                     count = 0;
                 }
                 count++;
 
-                if (inst_it == (*ib)->end())
+                if (inst_it == bb->end())
                 {
                     break;
                 }
             }
 
-            for (unsigned int i = 0; i < sections.size(); i++)
+            for (G4_BB* section : sections)
             {
-                (*ib)->splice((*ib)->end(), sections[i], sections[i]->begin(), sections[i]->end());
+                bb->splice(bb->end(), section, section->begin(), section->end());
             }
         }
         else
         {
-            G4_BB_Schedule schedule(fg.getKernel(), bbMem, *ib, LT, p);
-            bbInfo[i].id = (*ib)->getId();
+            G4_BB_Schedule schedule(fg.getKernel(), bbMem, bb, LT, p);
+            bbInfo[i].id = bb->getId();
             bbInfo[i].staticCycle = schedule.sequentialCycle;
             bbInfo[i].sendStallCycle = schedule.sendStallCycle;
-            bbInfo[i].loopNestLevel = (*ib)->getNestLevel();
-            totalCycles += schedule.sequentialCycle;
+            bbInfo[i].loopNestLevel = bb->getNestLevel();
+        }
+    };
+
+    unsigned numThreads = m_options->getuInt32Option(vISA_NumSchedulerThreads);
+    if (numThreads <= 1 || blocks.size() <= 1)
+    {
+        for (size_t i = 0; i < blocks.size(); i++)
+        {
+            scheduleBlock(i);
+        }
+    }
+    else
+    {
+        // The DDD and the schedule of a block only touch the instructions of
+        // that block, so blocks are scheduled independently on worker threads,
+        // each block with its own Mem_Manager. Splitting a block into windows
+        // creates new blocks in the flow graph, so those are done up front.
+        std::vector<size_t> parallelBlocks;
+        for (size_t i = 0; i < blocks.size(); i++)
+        {
+            if (needsWindows(blocks[i]))
+            {
+                scheduleBlock(i);
+            }
+            else
+            {
+                parallelBlocks.push_back(i);
+            }
+        }
+
+        TARGET_PLATFORM platform = fg.builder->getPlatform();
+        std::atomic<size_t> nextBlock(0);
+        auto worker = [&]()
+        {
+            // visa platform is thread local
+            SetVisaPlatform(platform);
+            for (size_t n = nextBlock++; n < parallelBlocks.size(); n = nextBlock++)
+            {
+                scheduleBlock(parallelBlocks[n]);
+            }
+        };
+
+        numThreads = std::min<unsigned>(numThreads, (unsigned)parallelBlocks.size());
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back(worker);
         }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+    }
 
-        i++;
+    uint32_t totalCycles = 0;
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        totalCycles += bbInfo[i].staticCycle;
     }
     FINALIZER_INFO* jitInfo = fg.builder->getJitInfo();
     jitInfo->BBInfo = bbInfo;
-    jitInfo->BBNum = i;
+    jitInfo->BBNum = (unsigned)blocks.size();
 
     fg.builder->getcompilerStats().SetI64(CompilerStats::numCyclesStr(), totalCycles, fg.getKernel()->getSimdSize());
 }
@@ -1335,11 +1408,14 @@ bool DDD::hasSameSourceOneDPAS(G4_INST *curInst, G4_INST *nextInst, BitSet &live
 // is inserted in all buckets it touches.
 DDD::DDD(Mem_Manager& m, G4_BB* bb, const LatencyTable& lt, G4_Kernel* k, PointsToAnalysis& p)
     : mem(m)
+    // m outlives the DDD and frees the edges with the nodes.
+    , depEdgeAllocator(std::shared_ptr<Mem_Manager>(&m, [](Mem_Manager*) {}))
     , LT(lt)
     , kernel(k)
     , pointsToAnalysis(p)
 {
     Node* lastBarrier = nullptr;
+    allNodes.reserve(bb->size());
     HWthreadsPerEU = k->getNumThreads();
     useMTLatencies = getBuilder()->useMultiThreadLatency();
     totalGRFNum = kernel->getNumRegTotal();
@@ -1584,16 +1660,13 @@ DDD::DDD(Mem_Manager& m, G4_BB* bb, const LatencyTable& lt, G4_Kernel* k, Points
         {
             LB.add(node, BD);
         }
-
-        // Insert this node into the graph.
-        InsertNode(node);
     }
 
-    if (Nodes.size())
+    if (allNodes.size())
     {
-        isThreeSouceBlock = ((float)threeSrcInstNUm / Nodes.size()) > THREE_SOURCE_BLOCK_HERISTIC;
+        isThreeSouceBlock = ((float)threeSrcInstNUm / allNodes.size()) > THREE_SOURCE_BLOCK_HERISTIC;
         is_2XFP_Block = (FP_InstNum >= FP_MIN_INST_NUM) &&
-            (((float)FP_InstNum / Nodes.size()) > THREE_SOURCE_BLOCK_HERISTIC) &&
+            (((float)FP_InstNum / allNodes.size()) > THREE_SOURCE_BLOCK_HERISTIC) &&
             (((float)sendInstNum / FP_InstNum) < FP_BLOCK_SEND_HERISTIC);
     }
 }
@@ -2089,6 +2162,19 @@ void DDD::dumpNodes(G4_BB *bb)
 }
 
 // Helper comparator for priority queue. Queue top is for lowest earliest cycle.
+// Queue of DAG nodes ordered by Cmp. A block never has more ready nodes than
+// nodes, so the heap storage is reserved once instead of regrown.
+template <typename Cmp>
+using NodeQueue = std::priority_queue<Node*, std::vector<Node*>, Cmp>;
+
+template <typename Cmp>
+static NodeQueue<Cmp> makeNodeQueue(size_t numNodes)
+{
+    std::vector<Node*> storage;
+    storage.reserve(numNodes);
+    return NodeQueue<Cmp>(Cmp(), std::move(storage));
+}
+
 struct earlyCmp {
     earlyCmp() = default;
     bool operator()(const Node *n1, const Node *n2)
@@ -2164,12 +2250,12 @@ uint32_t DDD::listScheduleForSuppression(G4_BB_Schedule* schedule)
     // All nodes in root set have no dependency
     // so they can be immediately scheduled,
     // and hence are added to readyList.
-    std::priority_queue<Node*, std::vector<Node*>, criticalCmpForMad> readyList;
+    auto readyList = makeNodeQueue<criticalCmpForMad>(allNodes.size());
 
     // Nodes with their predecessors scheduled are pushed into the preReadyQueue
     // They only get pushed into the real readyList if they are ready to issue,
     // that is their earliest cycle is >= than the current schedule cycle.
-    std::priority_queue<Node*, std::vector<Node*>, earlyCmp> preReadyQueue;
+    auto preReadyQueue = makeNodeQueue<earlyCmp>(allNodes.size());
 
     collectRoots();
     for (auto N : Roots) {
@@ -2328,14 +2414,14 @@ uint32_t DDD::listScheduleFor2xFP(G4_BB_Schedule* schedule)
     // so they can be immediately scheduled,
     // and hence are added to readyList.
     // 2xSP specific, the original order will be kept.
-    std::priority_queue<Node*, std::vector<Node*>, criticalCmpForMad> readyList;
+    auto readyList = makeNodeQueue<criticalCmpForMad>(allNodes.size());
 
     // Nodes with their predecessors scheduled are pushed into the preReadyQueue
     // They only get pushed into the real readyList if they are ready to issue,
     // that is their earliest cycle is >= than the current schedule cycle.
-    std::priority_queue<Node*, std::vector<Node*>, earlyCmp> preReadyQueue;
+    auto preReadyQueue = makeNodeQueue<earlyCmp>(allNodes.size());
 
-    auto updateForSucc = [&](Node* scheduled, std::priority_queue<Node*, std::vector<Node*>, earlyCmp>* preReadyQueue)
+    auto updateForSucc = [&](Node* scheduled, NodeQueue<earlyCmp>* preReadyQueue)
     {
         for (auto& curSucc : scheduled->succs)
         {
@@ -2551,14 +2637,14 @@ uint32_t DDD::listSchedule(G4_BB_Schedule *schedule)
     // All nodes in root set have no dependency
     // so they can be immediately scheduled,
     // and hence are added to readyList.
-    std::priority_queue<Node *, std::vector<Node *>, criticalCmp> readyList;
+    auto readyList = makeNodeQueue<criticalCmp>(allNodes.size());
 
     // Nodes with their predecessors scheduled are pushed into the preReadyQueue
     // They only get pushed into the real readyList if they are ready to issue,
     // that is their earliest cycle is >= than the current schedule cycle.
-    std::priority_queue<Node *, std::vector<Node *>, earlyCmp> preReadyQueue;
+    auto preReadyQueue = makeNodeQueue<earlyCmp>(allNodes.size());
 
-    auto updateForSucc = [&](Node* scheduled, std::priority_queue<Node*, std::vector<Node*>, earlyCmp>* preReadyQueue)
+    auto updateForSucc = [&](Node* scheduled, NodeQueue<earlyCmp>* preReadyQueue)
     {
         for (auto& curSucc : scheduled->succs)
         {
@@ -2948,6 +3034,8 @@ uint32_t DDD::getEdgeLatency(Node *node, DepType depT) {
 Node::Node(uint32_t id, G4_INST* inst, Edge_Allocator& depEdgeAllocator,
     const LatencyTable& LT)
     : nodeID(id)
+    , preds(depEdgeAllocator)
+    , succs(depEdgeAllocator)
 {
     instVec.push_back(inst);
     occupancy = LT.getOccupancy(inst);
@@ -2990,7 +3078,7 @@ void DDD::DumpDotFile(const char *name, const char* appendix){
     ofile << "\n" << "\t// Setup\n";
     ofile << "\tsize = \"80, 100\";\n";
     ofile << "\n" << "\t// Nodes\n";
-    std::list<Node*>::iterator iNode(Nodes.begin()), endNodes(Nodes.end());
+    auto iNode(allNodes.begin()), endNodes(allNodes.end());
     for (; iNode != endNodes; ++iNode) {
         for (G4_INST *inst : *(*iNode)->getInstructions()) {
 
@@ -3023,7 +3111,7 @@ void DDD::DumpDotFile(const char *name, const char* appendix){
     }
     ofile << "\n" << "\t// Edges\n";
 
-    for (iNode = Nodes.begin(); iNode != endNodes; ++iNode)
+    for (iNode = allNodes.begin(); iNode != endNodes; ++iNode)
     {
         Node *node = *iNode;
         EdgeVector::iterator iEdge(node->succs.begin()), endEdges(node->succs.end());
@@ -58,7 +58,10 @@ public:
 };
 
 typedef std_arena_based_allocator<Edge> Edge_Allocator;
-typedef std::vector<Edge> EdgeVector;
+// Edges are allocated from the arena of the DDD that owns the nodes. They
+// stay in per-node arrays rather than one compressed (CSR) array because
+// typed-write/URB pairing and createAddEdge edit edges after the DAG is built.
+typedef std::vector<Edge, Edge_Allocator> EdgeVector;
 
 class Node
 {
@@ -147,8 +150,6 @@ public:
 
 using NODE_VECT = std::vector<Node *>;
 using NODE_VECT_ITER = NODE_VECT::iterator;
-using NODE_LIST = std::list<Node *>;
-using NODE_LIST_ITER = NODE_LIST::iterator;
 
 // The mask describes the range of data touched by a bucket.
 struct Mask {
@@ -251,7 +252,7 @@ class DDD {
 public:
     typedef std::pair<Node *, Node *> instrPair_t;
     typedef std::vector<instrPair_t> instrPairVec_t;
-    NODE_LIST Nodes, Roots;
+    NODE_VECT Roots;
     void moveDeps(Node *fromNode, Node *toNode);
     void pairTypedWriteOrURBWriteNodes(G4_BB *bb);
 
@@ -262,18 +263,12 @@ public:
     DDD(Mem_Manager& m, G4_BB* bb, const LatencyTable& lt, G4_Kernel* k, PointsToAnalysis &p);
     ~DDD()
     {
-        if (Nodes.size())
+        for (Node *n : allNodes)
         {
-            for (NODE_LIST_ITER nIter = Nodes.begin(); nIter != Nodes.end(); nIter++)
-            {
-                Node *n = (*nIter);
-                n->~Node();
-            }
-            Nodes.clear();
+            n->~Node();
         }
     }
     void *operator new(size_t sz, Mem_Manager &m) { return m.alloc(sz); }
-    void InsertNode(Node *node) { Nodes.push_back(node); }
     void dumpNodes(G4_BB *bb);
     void dumpDagDot(G4_BB *bb);
     uint32_t listScheduleForSuppression(G4_BB_Schedule* schedule);
@@ -2042,8 +2042,10 @@ void SWSB::addToLiveList(SBNode* node)
 
 //
 //  Global reaching define analysis for tokens
+//  killedTokenNodes holds the send nodes of all tokens killed in bb,
+//  temp_live_in is scratch storage of the size of SBSendNodes.
 //
-bool SWSB::globalTokenReachAnalysis(G4_BB* bb)
+bool SWSB::globalTokenReachAnalysis(G4_BB* bb, const BitSet& killedTokenNodes, BitSet& temp_live_in)
 {
     bool changed = false;
     unsigned bbID = bb->getId();
@@ -2057,7 +2059,6 @@ bool SWSB::globalTokenReachAnalysis(G4_BB* bb)
 
     assert(BBVector[bbID]->liveInTokenNodes.getSize() != 0);
 
-    BitSet temp_live_in(unsigned(SBSendNodes.size()), false);
     temp_live_in = BBVector[bbID]->liveInTokenNodes;
 
     //Union all of out of SIMDCF predecessor BB to the live in of current BB.
@@ -2082,13 +2083,7 @@ bool SWSB::globalTokenReachAnalysis(G4_BB* bb)
     }
 
     //Calculate the live out according to the live in and killed tokens in current BB
-    for (uint32_t token = 0; token < totalTokenNum; token++)
-    {
-        if (BBVector[bbID]->killedTokens.isSet(token))
-        {
-            temp_live_in -= allTokenNodesMap[token].bitset;
-        }
-    }
+    temp_live_in -= killedTokenNodes;
 
     //Get the new live out,
     //FIXME: is it right? the live out is always assigned in increasing.
@@ -2102,13 +2097,33 @@ bool SWSB::globalTokenReachAnalysis(G4_BB* bb)
 
 void SWSB::SWSBGlobalTokenAnalysis()
 {
+    // Neither the killed tokens nor the token to node mapping change during
+    // the analysis, so fold them into one node mask per BB up front. Each
+    // iteration is then a handful of word-wide set operations per BB instead
+    // of one per killed token.
+    std::vector<BitSet> killedTokenNodes(BBVector.size());
+    for (G4_BB* bb : fg)
+    {
+        const G4_BB_SB* sb_bb = BBVector[bb->getId()];
+        BitSet& killed = killedTokenNodes[bb->getId()];
+        killed.resize(unsigned(SBSendNodes.size()));
+        for (uint32_t token = 0; token < totalTokenNum; token++)
+        {
+            if (sb_bb->killedTokens.isSet(token))
+            {
+                killed |= allTokenNodesMap[token].bitset;
+            }
+        }
+    }
+
+    BitSet temp_live_in(unsigned(SBSendNodes.size()), false);
     bool change = true;
     while (change)
     {
         change = false;
         for (G4_BB* bb : fg)
         {
-            if (globalTokenReachAnalysis(bb))
+            if (globalTokenReachAnalysis(bb, killedTokenNodes[bb->getId()], temp_live_in))
             {
                 change = true;
             }
@@ -2703,6 +2718,7 @@ void SWSB::allocateToken(G4_BB* bb)
 
     SBBitSets send_live(SBSendNodes.size());
     SBBitSets send_use(SBSendUses.size());
+    BitSet reachingSends(unsigned(SBSendNodes.size()), false);
 
     for (int i = BBVector[bb->getId()]->first_send_node; i <= BBVector[bb->getId()]->last_send_node; i++)
     {
@@ -2727,7 +2743,11 @@ void SWSB::allocateToken(G4_BB* bb)
             reachUseArray[k]->clear();
         }
 
-        for (size_t k = 0; k < SBSendNodes.size(); k++)
+        // Only visit the sends reaching the node rather than all sends.
+        reachingSends = send_live.dst;
+        reachingSends |= send_live.src;
+        for (int k = reachingSends.findFirstIn(0, reachingSends.getSize()); k != -1;
+             k = reachingSends.findFirstIn(k + 1, reachingSends.getSize()))
         {
             SBNode* liveNode = SBSendNodes[k];
             if ((liveNode->getLastInstruction()->getSetToken() != (unsigned short)UNKNOWN_TOKEN) &&
@@ -2742,19 +2762,17 @@ void SWSB::allocateToken(G4_BB* bb)
         if (!fg.builder->getOptions()->getOption(vISA_DistPropTokenAllocation) && (node->reachedUses.getSize() != 0))
         {
             send_use = node->reachedUses;    //The uses of other sends can be reached by current node.
-            for (size_t k = 0; k < SBSendUses.size(); k++)
+            for (int k = send_use.dst.findFirstIn(0, send_use.dst.getSize()); k != -1;
+                 k = send_use.dst.findFirstIn(k + 1, send_use.dst.getSize()))
             {
                 SBNode* liveNode = SBSendUses[k];
-                if (send_use.isDstSet(k))
+                for (size_t m = 0; m < liveNode->preds.size(); m++)
                 {
-                    for (size_t m = 0; m < liveNode->preds.size(); m++)
+                    SBDEP_ITEM& curPred = liveNode->preds[m];
+                    SBNode* pred = curPred.node;
+                    if (pred->getLastInstruction()->getSetToken() != (unsigned short)UNKNOWN_TOKEN)
                     {
-                        SBDEP_ITEM& curPred = liveNode->preds[m];
-                        SBNode* pred = curPred.node;
-                        if (pred->getLastInstruction()->getSetToken() != (unsigned short)UNKNOWN_TOKEN)
-                        {
-                            reachUseArray[pred->getLastInstruction()->getSetToken()]->push_back(liveNode);
-                        }
+                        reachUseArray[pred->getLastInstruction()->getSetToken()]->push_back(liveNode);
                     }
                 }
             }
@@ -1742,7 +1742,7 @@ namespace vISA
         void shareToken(const SBNode *node, const SBNode *succ, unsigned short token);
 
         void SWSBGlobalTokenAnalysis();
-        bool globalTokenReachAnalysis(G4_BB *bb);
+        bool globalTokenReachAnalysis(G4_BB *bb, const BitSet& killedTokenNodes, BitSet& temp_live_in);
 
 
         //Dump
@@ -32,6 +32,25 @@ namespace vISA
             return _arenaManager.AllocDataSpace(size, static_cast<size_t>(al));
         }
 
+        // While in scope, up to poolLimit bytes of arenas freed on the
+        // calling thread are kept for reuse by later Mem_Managers of the
+        // thread. The previous limit is restored, and the surplus arenas
+        // released, at the end of the scope. Outside any scope arenas go
+        // back to the heap.
+        class ArenaPoolScope
+        {
+        public:
+            explicit ArenaPoolScope(size_t poolLimit)
+                : prevLimit(ArenaManager::SetPoolLimit(poolLimit)) {}
+            ~ArenaPoolScope() { ArenaManager::SetPoolLimit(prevLimit); }
+
+            ArenaPoolScope(const ArenaPoolScope&) = delete;
+            ArenaPoolScope& operator=(const ArenaPoolScope&) = delete;
+
+        private:
+            size_t prevLimit;
+        };
+
     private:
 
         vISA::ArenaManager _arenaManager;
@@ -9,6 +9,7 @@ SPDX-License-Identifier: MIT
 #include "Optimizer.h"
 #include "G4_Opcode.h"
 #include "Timer.h"
+#include "Counters.h"
 #include "G4_Verifier.hpp"
 #include "ifcvt.h"
 #include "FlowGraph.h"
@@ -46,9 +47,10 @@ void Optimizer::LVN()
     Mem_Manager mem(1024);
     PointsToAnalysis p(kernel.Declares, kernel.fg.getNumBB());
     p.doPointsToAnalysis(kernel.fg);
+    LVNTables tables;
     for (auto bb : kernel.fg)
     {
-        ::LVN lvn(fg, bb, mem, *fg.builder, p);
+        ::LVN lvn(fg, bb, mem, *fg.builder, p, tables);
         lvn.doLVN();
 
         numInstsRemoved += lvn.getNumInstsRemoved();
@@ -1336,17 +1338,39 @@ void Optimizer::runPass(PassIndex Index)
 
     std::string Name = PI.Name;
 
-    if (PI.Timer != TimerID::NUM_TIMERS)
-        startTimer(PI.Timer);
+    auto countInsts = [this]()
+    {
+        size_t numInsts = 0;
+        for (G4_BB* bb : kernel.fg)
+        {
+            numInsts += bb->size();
+        }
+        return numInsts;
+    };
 
     kernel.dumpToFile("before." + Name);
 
+    // Every pass is measured, including those without a timer of their own.
+    size_t numInstsBefore = countInsts();
+    int64_t arenaBytesBefore = Counters::getThread(CounterID::ARENA_BYTES);
+    int64_t clockBefore = getTimerClock();
+
+    if (PI.Timer != TimerID::NUM_TIMERS)
+        startTimer(PI.Timer);
+
     // Execute pass.
     (this->*(PI.Pass))();
 
     if (PI.Timer != TimerID::NUM_TIMERS)
         stopTimer(PI.Timer);
 
+    int64_t ticks = getTimerClock() - clockBefore;
+    size_t numInsts = countInsts();
+    recordPassStats(PI.Name, ticks,
+        Counters::getThread(CounterID::ARENA_BYTES) - arenaBytesBefore,
+        (int64_t)numInsts - (int64_t)numInstsBefore);
+    Counters::addNamed("instructionsAfterPass", PI.Name, numInsts);
+
     kernel.dumpToFile("after." + Name);
 
 #ifdef _DEBUG
@@ -1401,7 +1425,7 @@ void Optimizer::initOptimizations()
     INITIALIZE_PASS(insertDummyCompactInst,  vISA_InsertDummyCompactInst,  TimerID::NUM_TIMERS);
     INITIALIZE_PASS(mergeScalarInst,         vISA_MergeScalar,             TimerID::OPTIMIZER);
     INITIALIZE_PASS(lowerMadSequence,        vISA_EnableMACOpt,            TimerID::OPTIMIZER);
-    INITIALIZE_PASS(LVN,                     vISA_LVN,                     TimerID::OPTIMIZER);
+    INITIALIZE_PASS(LVN,                     vISA_LVN,                     TimerID::LVN);
     INITIALIZE_PASS(ifCvt,                   vISA_ifCvt,                   TimerID::OPTIMIZER);
     INITIALIZE_PASS(dumpPayload,             vISA_dumpPayload,             TimerID::MISC_OPTS);
     INITIALIZE_PASS(normalizeRegion,         vISA_EnableAlways,            TimerID::MISC_OPTS);
@@ -1428,7 +1452,7 @@ void Optimizer::initOptimizations()
     INITIALIZE_PASS(removeInstrinsics,       vISA_removeInstrinsics,       TimerID::MISC_OPTS);
     INITIALIZE_PASS(expandMulPostSchedule,   vISA_expandMulPostSchedule,   TimerID::MISC_OPTS);
     INITIALIZE_PASS(zeroSomeARF,             vISA_zeroSomeARF,             TimerID::MISC_OPTS);
-    INITIALIZE_PASS(addSWSBInfo,             vISA_addSWSBInfo,             TimerID::MISC_OPTS);
+    INITIALIZE_PASS(addSWSBInfo,             vISA_addSWSBInfo,             TimerID::SWSB);
     INITIALIZE_PASS(expandMadwPostSchedule,  vISA_expandMadwPostSchedule,  TimerID::MISC_OPTS);
 
     // Verify all passes are initialized.
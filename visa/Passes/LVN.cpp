@@ -151,11 +151,10 @@ bool LVN::getDstData(int64_t srcImm, G4_Type srcType, int64_t& dstImm, G4_Type d
 bool LVN::getAllUses(G4_INST* def, UseList& uses)
 {
     bool defFound = false;
-    auto it = defUse.find(def);
-    if (it != defUse.end())
+    if (def->getLocalId() < defUse.size() && !defUse[def->getLocalId()].empty())
     {
         defFound = true;
-        uses = (*it).second;
+        uses = defUse[def->getLocalId()];
     }
 
     return defFound;
@@ -200,9 +199,7 @@ bool LVN::canReplaceUses(INST_LIST_ITER inst_it, UseList& uses, G4_INST* lvnInst
         unsigned int use_rb = use->getRightBound();
 
         // Ensure a single def flows in to the use
-        auto it = useDef.find(use);
-        if (it == useDef.end() ||
-            (*it).second.size() != 1)
+        if (getNumDefs(useInst, opndNum) != 1)
         {
             canReplace = false;
             break;
@@ -578,11 +575,11 @@ void LVN::removeVirtualVarRedefs(G4_DstRegRegion* dst)
     if (!dstTopDcl)
         return;
 
-    auto it = dclValueTable.find(dstTopDcl);
+    auto values = dclValueTable.find(dstTopDcl);
 
-    if (it != dclValueTable.end())
+    if (values)
     {
-        for (auto second = it->second.begin(), end = it->second.end();
+        for (auto second = values->begin(), end = values->end();
             second != end;
             )
         {
@@ -635,13 +632,11 @@ void LVN::removeVirtualVarRedefs(G4_DstRegRegion* dst)
         // ...
         // V10 = 0 <-- Current instruction - Invalidate inst1
         // V30 = r[A0] <-- inst1 != this inst
-        for (auto dcls : lvnTable)
+        // As in removePhysicalVarRedefs, items stay in their bucket.
+        for (auto& dcls : lvnTable)
         {
-            for (auto second = dcls.second.begin();
-                second != dcls.second.end();
-                )
+            for (auto lvnItems : dcls.second)
             {
-                auto lvnItems = (*second);
                 auto lvnItemsInst = lvnItems->inst;
 
                 for (unsigned int i = 0; i < G4_MAX_SRCS; i++)
@@ -654,22 +649,14 @@ void LVN::removeVirtualVarRedefs(G4_DstRegRegion* dst)
                         if (p2a.isPresentInPointsTo(lvnItemsInst->getSrc(i)->asSrcRegRegion()->getTopDcl()->getRegVar(), dst->getTopDcl()->getRegVar()))
                         {
                             lvnItems->active = false;
-                            second = dcls.second.erase(second);
 
                             for (auto use : lvnItems->uses)
                             {
                                 use->active = false;
                             }
-                            continue;
                         }
                     }
                 }
-                if (second != dcls.second.end())
-                {
-                    // Increment iterator only if dcls.second is not empty.
-                    // Erase operation in earlier loop can result in this.
-                    second++;
-                }
             }
         }
     }
@@ -700,22 +687,18 @@ bool LVN::sameGRFRef(G4_Declare* dcl1, G4_Declare* dcl2)
 void LVN::removePhysicalVarRedefs(G4_DstRegRegion* dst)
 {
     G4_Declare* topdcl = dst->getTopDcl();
-    for (auto all : lvnTable)
+    // Items are only deactivated here. They must stay in their bucket, as
+    // addValueToTable may re-activate an operand value of current inst.
+    for (auto& all : lvnTable)
     {
-        for (auto it = all.second.begin();
-            it != all.second.end();
-            )
+        for (auto item : all.second)
         {
-            auto item = (*it);
-            bool erase = false;
-
             auto dstTopDcl = item->inst->getDst() ? item->inst->getDst()->getTopDcl() : nullptr;
             if (dstTopDcl->getRegVar()->isGreg())
             {
                 if (sameGRFRef(topdcl, dstTopDcl))
                 {
                     item->active = false;
-                    erase = true;
                 }
             }
 
@@ -729,18 +712,9 @@ void LVN::removePhysicalVarRedefs(G4_DstRegRegion* dst)
                     if (sameGRFRef(topdcl, srcTopDcl))
                     {
                         item->active = false;
-                        erase = true;
                     }
                 }
             }
-
-            if (erase)
-            {
-                it = all.second.erase(it);
-                continue;
-            }
-
-            it++;
         }
     }
 }
@@ -773,11 +747,11 @@ void LVN::removeAliases(G4_INST* inst)
     for (auto item : *dstPointsToPtr)
     {
         auto dcl = item.var->getDeclare()->getRootDeclare();
-        auto it = dclValueTable.find(dcl);
-        if (it == dclValueTable.end())
+        auto values = dclValueTable.find(dcl);
+        if (!values)
             continue;
 
-        for (auto d : it->second)
+        for (auto d : *values)
         {
             d->active = false;
 #ifdef DEBUG_VERBOSE_ON
@@ -924,8 +898,8 @@ LVNItemInfo* LVN::getOpndValue(G4_Operand* opnd, bool create)
         }
     }
 
-    auto it = dclValueTable.find(topdcl);
-    if (it == dclValueTable.end())
+    auto values = dclValueTable.find(topdcl);
+    if (!values)
     {
         if (!create)
         {
@@ -933,9 +907,9 @@ LVNItemInfo* LVN::getOpndValue(G4_Operand* opnd, bool create)
         }
     }
 
-    if (it != dclValueTable.end())
+    if (values)
     {
-        for (auto& item : (*it).second)
+        for (auto& item : *values)
         {
             if (!item->active)
                 continue;
@@ -972,7 +946,7 @@ void LVN::getValue(G4_SrcRegRegion* src, G4_INST* inst, Value& value)
     auto lvnItemInfo = getOpndValue(src);
     if (lvnItemInfo->value.isValueEmpty())
     {
-        lvnItemInfo->value.hash = topdcl->getDeclId() + src->getLeftBound() + src->getRightBound() + getActualHStride(src) + dclValueTable.size();
+        lvnItemInfo->value.hash = topdcl->getDeclId() + src->getLeftBound() + src->getRightBound() + getActualHStride(src) + numValueDcls;
         lvnItemInfo->value.inst = inst;
         perInstValueCache.push_back(std::make_pair(topdcl, lvnItemInfo));
     }
@@ -986,7 +960,7 @@ void LVN::getValue(G4_DstRegRegion* dst, G4_INST* inst, Value& value)
     auto lvnItemInfo = getOpndValue(dst);
     if (lvnItemInfo->value.isValueEmpty())
     {
-        lvnItemInfo->value.hash = topdcl->getDeclId() + dst->getLeftBound() + dst->getRightBound() + dst->getHorzStride() + dclValueTable.size();
+        lvnItemInfo->value.hash = topdcl->getDeclId() + dst->getLeftBound() + dst->getRightBound() + dst->getHorzStride() + numValueDcls;
         lvnItemInfo->value.inst = inst;
         perInstValueCache.push_back(std::make_pair(topdcl, lvnItemInfo));
     }
@@ -1001,13 +975,13 @@ void LVN::invalidateOldDstValue(G4_INST* inst)
     auto topdcl = inst->getDst()->getTopDcl();
     if (!topdcl)
         return;
-    auto it = dclValueTable.find(topdcl);
-    if (it == dclValueTable.end())
+    auto values = dclValueTable.find(topdcl);
+    if (!values)
         return;
 
     auto lb = inst->getDst()->getLeftBound();
     auto rb = inst->getDst()->getRightBound();
-    for (auto& item : (*it).second)
+    for (auto& item : *values)
     {
         if (!item->active)
             continue;
@@ -1491,10 +1465,10 @@ LVNItemInfo* LVN::isValueInTable(Value& value, bool negate)
     int64_t hash = value.hash;
 
     auto bucket = lvnTable.find(hash);
-    if (bucket != lvnTable.end())
+    if (bucket)
     {
-        for (auto it = bucket->second.rbegin();
-            it != bucket->second.rend();
+        for (auto it = bucket->rbegin();
+            it != bucket->rend();
             )
         {
             auto lvnItem = (*it);
@@ -1516,10 +1490,10 @@ void LVN::addValueToTable(G4_INST* inst, Value& oldValue)
 {
     auto findLVNItemInfo = [this](G4_INST* inst, G4_Operand* opnd)
     {
-        auto it = dclValueTable.find(opnd->getTopDcl());
-        MUST_BE_TRUE(it != dclValueTable.end(), "Value not added");
+        auto values = dclValueTable.find(opnd->getTopDcl());
+        MUST_BE_TRUE(values, "Value not added");
         LVNItemInfo* lvnItem = nullptr;
-        for (auto item : (*it).second)
+        for (auto item : *values)
         {
             if (item->inst == inst &&
                 opnd->getInst() == item->inst)
@@ -1534,17 +1508,7 @@ void LVN::addValueToTable(G4_INST* inst, Value& oldValue)
 
     auto insertInLvnTable = [this](int64_t key, LVNItemInfo* itemToIns)
     {
-        auto it = lvnTable.find(key);
-        if (it != lvnTable.end())
-        {
-            it->second.push_back(itemToIns);
-        }
-        else
-        {
-            std::list<vISA::LVNItemInfo*> second;
-            second.push_back(itemToIns);
-            lvnTable.insert(make_pair(key, second));
-        }
+        lvnTable[key].push_back(itemToIns);
         itemToIns->active = true;
     };
 
@@ -1566,10 +1530,10 @@ void LVN::addValueToTable(G4_INST* inst, Value& oldValue)
             {
                 auto srcLb = src->getLeftBound();
                 auto srcRb = src->getRightBound();
-                auto it = dclValueTable.find(src->getTopDcl());
-                if (it != dclValueTable.end())
+                auto values = dclValueTable.find(src->getTopDcl());
+                if (values)
                 {
-                    for (auto l : (*it).second)
+                    for (auto l : *values)
                     {
                         if (l->active)
                         {
@@ -1589,9 +1553,13 @@ void LVN::addValueToTable(G4_INST* inst, Value& oldValue)
 
     for (auto& item : perInstValueCache)
     {
-        auto it = dclValueTable.find(item.first);
         item.second->active = true;
-        dclValueTable[item.first].push_back(item.second);
+        auto& values = dclValueTable[item.first];
+        if (values.empty())
+        {
+            numValueDcls++;
+        }
+        values.push_back(item.second);
     }
 
     auto lvnItem = findLVNItemInfo(inst, inst->getDst());
@@ -1618,53 +1586,52 @@ void LVN::addUse(G4_DstRegRegion* dst, G4_INST* use, unsigned int srcIndex)
     }
 
     UseInfo useInst = { use, srcPos };
-    auto it = defUse.find(dst->getInst());
+    defUse[dst->getInst()->getLocalId()].push_back(useInst);
 
-    if (it == defUse.end())
-    {
-        UseList uses = { useInst };
+    numUseDefs[use->getLocalId() * G4_MAX_SRCS + srcIndex]++;
+}
 
-        defUse.insert(std::make_pair(dst->getInst(), uses));
-    }
-    else
+unsigned int LVN::getNumDefs(G4_INST* use, Gen4_Operand_Number opndNum) const
+{
+    // addUse records uses in src3 as Opnd_dst, which has no entry.
+    if (opndNum != Opnd_src0 && opndNum != Opnd_src1 && opndNum != Opnd_src2)
     {
-        (*it).second.push_back(useInst);
+        return 0;
     }
 
-    auto srcOpnd = use->getSrc(srcIndex);
-    auto itUD = useDef.find(srcOpnd);
-    if (itUD == useDef.end())
-    {
-        DefList defs = { dst->getInst() };
-        useDef.insert(std::make_pair(srcOpnd, defs));
-    }
-    else
-    {
-        (*itUD).second.push_back(dst->getInst());
-    }
+    return numUseDefs[use->getLocalId() * G4_MAX_SRCS + G4_INST::getSrcNum(opndNum)];
 }
 
 void LVN::removeAddrTaken(G4_AddrExp* opnd)
 {
     G4_Declare* opndTopDcl = opnd->getRegVar()->getDeclare()->getRootDeclare();
 
-    auto range_it = activeDefs.equal_range(opndTopDcl->getDeclId());
-    for (auto it = range_it.first;
-        it != range_it.second;
-        )
+    auto defs = activeDefs.find(opndTopDcl);
+    if (!defs)
     {
-        auto prev_it = it;
-        (*prev_it).second.second->getInst()->removeAllUses();
-        it++;
-        activeDefs.erase(prev_it);
+        return;
     }
+
+    for (auto def : *defs)
+    {
+        def->getInst()->removeAllUses();
+    }
+    defs->clear();
 }
 
 void LVN::populateDuTable(INST_LIST_ITER inst_it)
 {
     duTablePopulated = true;
     // Populate duTable from inst_it position
-    ActiveDefMMap activeDefs;
+    ActiveDefTable& activeDefs = duActiveDefs;
+    activeDefs.clear();
+    if (defUse.empty())
+    {
+        // Local ids were assigned in doLVN and instructions are only
+        // removed after the table is populated.
+        defUse.resize(bb->size());
+        numUseDefs.resize(bb->size() * G4_MAX_SRCS);
+    }
     G4_INST* startInst = (*inst_it);
     G4_Operand* startInstDst = startInst->getDst();
     INST_LIST_ITER lastInstIt = bb->end();
@@ -1696,8 +1663,8 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it)
                 G4_Declare* topdcl = opnd->getTopDcl();
                 if (topdcl != NULL)
                 {
-                    auto range_it = activeDefs.equal_range(topdcl->getDeclId());
-                    if (range_it.first == range_it.second)
+                    auto defs = activeDefs.find(topdcl);
+                    if (!defs)
                     {
                         // No match found so move on to next src opnd
                         continue;
@@ -1707,14 +1674,11 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it)
                     unsigned int rb = opnd->getRightBound();
                     unsigned int hs = getActualHStride(opnd->asSrcRegRegion());
 
-                    auto start_it = range_it.second;
-                    start_it--;
-                    bool done = false;
-                    for (auto it = start_it;
-                        ;
-                        )
+                    for (auto it = defs->rbegin(), end = defs->rend();
+                        it != end;
+                        it++)
                     {
-                        G4_DstRegRegion* activeDst = (*it).second.second;
+                        G4_DstRegRegion* activeDst = (*it);
 
                         unsigned int lb_dst = activeDst->getLeftBound();
                         unsigned int rb_dst = activeDst->getRightBound();
@@ -1756,14 +1720,6 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it)
                                 break;
                             }
                         }
-
-                        if (done ||
-                            it == range_it.first)
-                        {
-                            // Last match reached
-                            break;
-                        }
-                        it--;
                     }
                 }
             }
@@ -1776,12 +1732,12 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it)
             if (curDstTopDcl != NULL)
             {
                 // Check if already an overlapping dst region is active
-                auto range_it = activeDefs.equal_range(curDstTopDcl->getDeclId());
-                for (auto it = range_it.first;
-                    it != range_it.second;
+                auto& defs = activeDefs[curDstTopDcl];
+                for (auto it = defs.begin();
+                    it != defs.end();
                     )
                 {
-                    G4_DstRegRegion* activeDst = (*it).second.second;
+                    G4_DstRegRegion* activeDst = (*it);
 
                     unsigned int lb = dst->getLeftBound();
                     unsigned int rb = dst->getRightBound();
@@ -1799,9 +1755,7 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it)
                             // Current dst completely overlaps
                             // earlier def so retire earlier
                             // active def.
-                            auto prev_it = it;
-                            it++;
-                            activeDefs.erase(prev_it);
+                            it = defs.erase(it);
                             continue;
                         }
                     }
@@ -1816,7 +1770,7 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it)
                 }
 
                 if (addValueToDU ||
-                    (activeDefs.find(curDstTopDcl->getDeclId()) != activeDefs.end()))
+                    !defs.empty())
                 {
                     // mov (8) V10(0,0):d     r0.0:d - 1
                     // shr (1) V10(0,1):d     0x1:d  - 2
@@ -1828,10 +1782,7 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it)
                     // the LVN table too. If first instruction wasnt an LVN
                     // candidate by itself, we wouldnt insert it or inst 2 in
                     // active def table.
-                    ActiveDef newActiveDef;
-                    newActiveDef.first = curDstTopDcl;
-                    newActiveDef.second = dst;
-                    activeDefs.emplace(curDstTopDcl->getDeclId(), newActiveDef);
+                    defs.push_back(dst);
                 }
             }
         }
@@ -2046,6 +1997,8 @@ unsigned int LVN::removeRedundantSamplerMovs(G4_Kernel& kernel, G4_BB* bb)
 
 LVN::~LVN()
 {
+    dclValueTable.clear();
+    duActiveDefs.clear();
     for (auto d : toDtor)
     {
         d->~LVNItemInfo();
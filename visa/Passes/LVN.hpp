@@ -73,41 +73,160 @@ namespace vISA
 // in case of immediates the key maps to respective operands. Having
 // a map allows faster lookups and lesser number of comparisons than a
 // running list of all instructions seen so far.
-typedef std::unordered_map<int64_t, std::list<vISA::LVNItemInfo*>> LvnTable;
+//
+// Buckets are kept in a flat vector in insertion order and located through
+// an open-addressing index with linear probing. Keys are never removed, so
+// the index needs no tombstones.
+class LvnTable
+{
+public:
+    typedef std::vector<vISA::LVNItemInfo*> Bucket;
+    typedef std::vector<std::pair<int64_t, Bucket>> BucketVector;
+
+    // Return the bucket for key, or nullptr if there is none.
+    Bucket* find(int64_t key)
+    {
+        if (buckets.empty())
+            return nullptr;
+
+        const size_t mask = index.size() - 1;
+        for (size_t slot = getSlot(key); index[slot] != 0; slot = (slot + 1) & mask)
+        {
+            auto& bucket = buckets[index[slot] - 1];
+            if (bucket.first == key)
+                return &bucket.second;
+        }
+        return nullptr;
+    }
+
+    // Return the bucket for key, creating an empty one if necessary.
+    Bucket& operator[](int64_t key)
+    {
+        if (Bucket* bucket = find(key))
+            return *bucket;
+
+        // keep the load factor at or below 1/2
+        if ((buckets.size() + 1) * 2 > index.size())
+            grow();
+        buckets.emplace_back(key, Bucket());
+        insertInIndex(key, (unsigned)buckets.size());
+        return buckets.back().second;
+    }
+
+    BucketVector::iterator begin() { return buckets.begin(); }
+    BucketVector::iterator end() { return buckets.end(); }
+
+private:
+    BucketVector buckets;
+    // 0 marks an empty slot, otherwise the slot holds bucket index + 1.
+    std::vector<unsigned> index;
+    unsigned shift = 64;
+
+    size_t getSlot(int64_t key) const
+    {
+        // Fibonacci hashing; dcl ids and small immediates are dense.
+        return (size_t)(((uint64_t)key * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
+
+    void insertInIndex(int64_t key, unsigned bucketNum)
+    {
+        const size_t mask = index.size() - 1;
+        size_t slot = getSlot(key);
+        while (index[slot] != 0)
+            slot = (slot + 1) & mask;
+        index[slot] = bucketNum;
+    }
+
+    void grow()
+    {
+        const unsigned InitialSlots = 64;
+        index.assign(index.empty() ? InitialSlots : index.size() * 2, 0);
+        shift = 64;
+        for (size_t n = index.size(); n > 1; n >>= 1)
+            shift--;
+        for (unsigned i = 0; i != buckets.size(); i++)
+            insertInIndex(buckets[i].first, i + 1);
+    }
+};
+
+// Table indexed by declare id. Ids are dense but not bounded by the number
+// of declares of the kernel (they are offset when kernels are stitched), so
+// the table grows on demand. It is meant to be reused across the BBs of a
+// kernel: clear() only empties the entries filled since the last clear.
+template <class T>
+class DclIdTable
+{
+public:
+    // Return the entry for dcl, or nullptr if it is empty.
+    T* find(const vISA::G4_Declare* dcl)
+    {
+        unsigned id = dcl->getDeclId();
+        if (id >= entries.size() || entries[id].empty())
+            return nullptr;
+        return &entries[id];
+    }
+
+    T& operator[](const vISA::G4_Declare* dcl)
+    {
+        unsigned id = dcl->getDeclId();
+        if (id >= entries.size())
+            entries.resize(id + 1);
+        if (entries[id].empty())
+            touched.push_back(id);
+        return entries[id];
+    }
+
+    void clear()
+    {
+        for (unsigned id : touched)
+            entries[id].clear();
+        touched.clear();
+    }
+
+private:
+    std::vector<T> entries;
+    // Ids of the entries that may be non-empty
+    std::vector<unsigned> touched;
+};
+
 typedef struct UseInfo
 {
     vISA::G4_INST* first;
     Gen4_Operand_Number second;
 } UseInfo;
-typedef std::list<UseInfo> UseList;
-typedef std::list<vISA::G4_INST*> DefList;
+typedef std::vector<UseInfo> UseList;
 
-typedef struct DefUseInfo
-{
-    vISA::G4_INST* first;
-    UseList second;
-} DefUseInfo;
-typedef std::multimap<unsigned int, DefUseInfo> DefUseTable;
+// Active defs of each top dcl in program order.
+typedef DclIdTable<std::vector<vISA::G4_DstRegRegion*>> ActiveDefTable;
 
-typedef struct ActiveDef
+// Declare indexed tables of LVN, shared by the LVN runs on the BBs of a
+// kernel so that a BB does not pay for the declares it does not touch.
+// Each LVN leaves them empty when it is done.
+struct LVNTables
 {
-    vISA::G4_Declare* first;
-    vISA::G4_DstRegRegion* second;
-} ActiveDef;
-typedef std::multimap<unsigned int, ActiveDef> ActiveDefMMap;
+    DclIdTable<std::vector<vISA::LVNItemInfo*>> dclValues;
+    ActiveDefTable duActiveDefs;
+};
 
 namespace vISA
 {
     class LVN
     {
     private:
-        std::map<G4_INST*, UseList> defUse;
-        std::map<G4_Operand*, DefList> useDef;
-        std::unordered_map<G4_Declare*, std::list<LVNItemInfo*>> dclValueTable;
+        // Uses of each def, indexed by the local id of the def instruction.
+        std::vector<UseList> defUse;
+        // Number of defs reaching each src operand, indexed by
+        // local id of the use instruction * G4_MAX_SRCS + src number.
+        std::vector<unsigned> numUseDefs;
+        DclIdTable<std::vector<LVNItemInfo*>>& dclValueTable;
+        // Number of dcls in dclValueTable, part of the operand value hash.
+        unsigned int numValueDcls = 0;
         G4_BB* bb;
         FlowGraph& fg;
         LvnTable lvnTable;
-        ActiveDefMMap activeDefs;
+        ActiveDefTable activeDefs;
+        // Active defs while populating the DU table
+        ActiveDefTable& duActiveDefs;
         vISA::Mem_Manager& mem;
         IR_Builder& builder;
         unsigned int numInstsRemoved;
@@ -121,6 +240,7 @@ namespace vISA
         void populateDuTable(INST_LIST_ITER inst_it);
         void removeAddrTaken(G4_AddrExp* opnd);
         void addUse(G4_DstRegRegion* dst, G4_INST* use, unsigned int srcIndex);
+        unsigned int getNumDefs(G4_INST* use, Gen4_Operand_Number opndNum) const;
         void addValueToTable(G4_INST* inst, Value& oldValue);
         LVNItemInfo* isValueInTable(Value& value, bool negate);
         bool isSameValue(Value& val1, Value& val2, bool negImmVal);
@@ -157,8 +277,10 @@ namespace vISA
         void invalidate();
 
     public:
-        LVN(FlowGraph& flowGraph, G4_BB* curBB, vISA::Mem_Manager& mmgr, IR_Builder& irBuilder, PointsToAnalysis& p) :
-            fg(flowGraph), mem(mmgr), builder(irBuilder), p2a(p)
+        LVN(FlowGraph& flowGraph, G4_BB* curBB, vISA::Mem_Manager& mmgr, IR_Builder& irBuilder, PointsToAnalysis& p,
+            LVNTables& tables) :
+            dclValueTable(tables.dclValues), fg(flowGraph), duActiveDefs(tables.duActiveDefs),
+            mem(mmgr), builder(irBuilder), p2a(p)
         {
             bb = curBB;
             numInstsRemoved = 0;
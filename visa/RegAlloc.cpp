@@ -13,12 +13,16 @@ SPDX-License-Identifier: MIT
 #include "Timer.h"
 #include "DebugInfo.h"
 #include "VarSplit.h"
+#include "SCCAnalysis.h"
 
 #include <bitset>
 #include <climits>
 #include <cmath>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
 using namespace vISA;
@@ -957,7 +961,7 @@ void LivenessAnalysis::detectNeverDefinedVarRows()
 // uses of reg vars are anticipated, which tell use the uses of reg vars.Def and Use vectors encapsulate the liveness
 // of reg vars.
 //
-void LivenessAnalysis::computeLiveness()
+void LivenessAnalysis::computeLiveness(LivenessSnapshot* snapshot)
 {
     //
     // no reg var is selected, then no need to compute liveness
@@ -1045,11 +1049,32 @@ void LivenessAnalysis::computeLiveness()
     //
     // compute def_out and use_in vectors for each BB
     //
+    if (snapshot)
+    {
+        prepareSnapshot(*snapshot);
+    }
+    unsigned numRescanned = 0;
+    std::vector<std::pair<G4_Declare*, G4_INST*>> pseudoKills;
     for (G4_BB * bb  : fg)
     {
         unsigned id = bb->getId();
 
-        computeGenKillandPseudoKill(bb, def_out[id], use_in[id], use_gen[id], use_kill[id]);
+        if (!snapshot)
+        {
+            computeGenKillandPseudoKill(bb, def_out[id], use_in[id], use_gen[id], use_kill[id]);
+        }
+        else
+        {
+            // Signature is taken before pseudo kills are inserted
+            uint64_t signature = computeGenKillSignature(bb);
+            if (!restoreGenKill(bb, signature, *snapshot))
+            {
+                pseudoKills.clear();
+                computeGenKillandPseudoKill(bb, def_out[id], use_in[id], use_gen[id], use_kill[id], &pseudoKills);
+                saveGenKill(bb, signature, pseudoKills, *snapshot);
+                numRescanned++;
+            }
+        }
 
         //
         // exit block: mark output parameters live
@@ -1060,6 +1085,11 @@ void LivenessAnalysis::computeLiveness()
         }
     }
 
+    if (snapshot && fg.builder->getOption(vISA_RATrace))
+    {
+        std::cout << "\t--incremental liveness: rescanning " << numRescanned << " of " << fg.size() << " BBs\n";
+    }
+
     G4_BB* subEntryBB = NULL;
     SparseBitSet* subEntryKill = NULL;
     SparseBitSet* subEntryGen = NULL;
@@ -1140,41 +1170,38 @@ void LivenessAnalysis::computeLiveness()
 #endif
     }
 
-    auto getPostOrder = [](G4_BB *S, std::vector<G4_BB *> &PO) {
-      std::stack<std::pair<G4_BB *, BB_LIST_ITER>> Stack;
-      std::set<G4_BB *> Visited;
-
-      Stack.push({S, S->Succs.begin()});
-      Visited.insert(S);
-      while (!Stack.empty()) {
-        G4_BB *Curr = Stack.top().first;
-        BB_LIST_ITER It = Stack.top().second;
-
-        if (It != Curr->Succs.end()) {
-          G4_BB *Child = *Stack.top().second++;
-          if (Visited.insert(Child).second) {
-            Stack.push({Child, Child->Succs.begin()});
-          }
-          continue;
+    //
+    // Solve the data flow one SCC at a time, in dependence order, so each
+    // SCC only iterates until its own BBs are stable. BBs that are not
+    // reachable from the entry keep their local sets.
+    //
+    SCCOrder sccs(fg);
+    auto isTrivialSCC = [&sccs](unsigned scc)
+    {
+        auto first = sccs.body_begin(scc);
+        if (first + 1 != sccs.body_end(scc))
+        {
+            return false;
         }
-        PO.push_back(Curr);
-        Stack.pop();
-      }
+        G4_BB* bb = *first;
+        return std::find(bb->Succs.begin(), bb->Succs.end(), bb) == bb->Succs.end();
     };
 
-    std::vector<G4_BB *> PO;
-    getPostOrder(fg.getEntryBB(), PO);
-
-    bool change;
-
     //
     // backward flow analysis to propagate uses (locate last uses)
     //
-    do {
-        change = false;
-        for (auto I = PO.begin(), E = PO.end(); I != E; ++I)
-            change |= contextFreeUseAnalyze(*I, change);
-    } while (change);
+    // Within a sweep, once a BB changed the sweep is repeated anyway, so the
+    // remaining BBs skip the comparison. A trivial SCC is swept only once.
+    solveSCCs(sccs, true, [&](unsigned scc)
+    {
+        const bool trivial = isTrivialSCC(scc);
+        bool change;
+        do {
+            change = trivial;
+            for (auto I = sccs.body_end(scc), E = sccs.body_begin(scc); I != E;)
+                change |= contextFreeUseAnalyze(*--I, change);
+        } while (change && !trivial);
+    });
 
     //
     // initialize entry block with payload input
@@ -1184,11 +1211,16 @@ void LivenessAnalysis::computeLiveness()
     //
     // forward flow analysis to propagate defs (locate first defs)
     //
-    do {
-        change = false;
-        for (auto I = PO.rbegin(), E = PO.rend(); I != E; ++I)
-            change |= contextFreeDefAnalyze(*I, change);
-    } while (change);
+    solveSCCs(sccs, false, [&](unsigned scc)
+    {
+        const bool trivial = isTrivialSCC(scc);
+        bool change;
+        do {
+            change = trivial;
+            for (auto I = sccs.body_begin(scc), E = sccs.body_end(scc); I != E; ++I)
+                change |= contextFreeDefAnalyze(*I, change);
+        } while (change && !trivial);
+    });
 
 #if 0
     // debug code to compare old v. new IPA
@@ -1837,7 +1869,9 @@ void LivenessAnalysis::computeGenKillandPseudoKill(G4_BB* bb,
                                                    SparseBitSet& def_out,
                                                    SparseBitSet& use_in,
                                                    SparseBitSet& use_gen,
-                                                   SparseBitSet& use_kill) const
+                                                   SparseBitSet& use_kill,
+                                                   std::vector<std::pair<G4_Declare*, G4_INST*>>* pseudoKillsInserted,
+                                                   bool insertPseudoKills) const
 {
     //
     // Mark each fcall as using all globals and arg pre-defined var
@@ -2290,8 +2324,15 @@ void LivenessAnalysis::computeGenKillandPseudoKill(G4_BB* bb,
         {
             --iterToInsert;
         } while ((*iterToInsert)->isPseudoKill());
-        G4_INST* killInst = fg.builder->createPseudoKill(pseudoKill.first, PseudoKillType::FromLiveness);
-        bb->insertBefore(iterToInsert, killInst);
+        if (pseudoKillsInserted)
+        {
+            pseudoKillsInserted->emplace_back(pseudoKill.first, *iterToInsert);
+        }
+        if (insertPseudoKills)
+        {
+            G4_INST* killInst = fg.builder->createPseudoKill(pseudoKill.first, PseudoKillType::FromLiveness);
+            bb->insertBefore(iterToInsert, killInst);
+        }
     }
 
     //
@@ -2300,6 +2341,296 @@ void LivenessAnalysis::computeGenKillandPseudoKill(G4_BB* bb,
     use_in = use_gen;
 }
 
+//
+// Besides the instructions, gen and kill of a BB depend on properties of
+// the variables it references that may change between RA iterations.
+//
+uint64_t LivenessAnalysis::computeGenKillSignature(G4_BB* bb) const
+{
+    uint64_t sig = Interference::computeBBSignature(bb);
+    auto mix = [&sig](uint64_t val)
+    {
+        sig = (sig ^ val) * 0x100000001b3ULL;
+    };
+    const unsigned bytesPerGRF = fg.builder->numEltPerGRF<Type_UB>();
+    auto mixDcl = [&](const G4_Declare* dcl)
+    {
+        if (!dcl)
+        {
+            return;
+        }
+        mix(gra.isBlockLocal(dcl));
+        mix((uint64_t)(uintptr_t)gra.getLocalLR(dcl));
+        auto it = neverDefinedRows.find(const_cast<G4_Declare*>(dcl));
+        if (it != neverDefinedRows.end())
+        {
+            for (unsigned i = 0; i < it->second.getSize(); i += bytesPerGRF)
+            {
+                mix(it->second.isSet(i));
+            }
+        }
+    };
+
+    for (G4_INST* inst : *bb)
+    {
+        if (inst->getDst())
+        {
+            mixDcl(inst->getDst()->getTopDcl());
+        }
+        for (int i = 0, numSrc = inst->getNumSrc(); i < numSrc; i++)
+        {
+            G4_Operand* src = inst->getSrc(i);
+            if (src && src->isSrcRegRegion())
+            {
+                mixDcl(src->getTopDcl());
+            }
+        }
+        if (inst->getPredicate())
+        {
+            mixDcl(inst->getPredicate()->getTopDcl());
+        }
+        if (inst->getCondMod())
+        {
+            mixDcl(inst->getCondMod()->getTopDcl());
+        }
+    }
+
+    return sig;
+}
+
+//
+// Drop the whole snapshot if it was taken for other register files or if
+// a variable became a liveness candidate since; either changes the sets
+// even of BBs that are otherwise unchanged.
+//
+void LivenessAnalysis::prepareSnapshot(LivenessSnapshot& snapshot) const
+{
+    std::vector<bool> candidates;
+    for (auto var : vars)
+    {
+        if (!var)
+        {
+            continue;
+        }
+        unsigned declId = var->getDeclare()->getDeclId();
+        if (declId >= candidates.size())
+        {
+            candidates.resize(declId + 1, false);
+        }
+        candidates[declId] = true;
+    }
+
+    bool valid = snapshot.selectedRF == selectedRF;
+    for (size_t i = 0, e = std::min(candidates.size(), snapshot.candidates.size()); valid && i < e; i++)
+    {
+        valid = snapshot.candidates[i] || !candidates[i];
+    }
+
+    if (!valid)
+    {
+        snapshot.bbSets.clear();
+    }
+    snapshot.bbSets.resize(numBBId);
+    snapshot.selectedRF = selectedRF;
+    snapshot.candidates = std::move(candidates);
+}
+
+bool LivenessAnalysis::restoreGenKill(G4_BB* bb, uint64_t signature, const LivenessSnapshot& snapshot)
+{
+    unsigned id = bb->getId();
+    const LivenessSnapshot::BBSets& sets = snapshot.bbSets[id];
+    if (!sets.valid || sets.signature != signature)
+    {
+        return false;
+    }
+
+    auto toBits = [this](const std::vector<G4_Declare*>& dcls, SparseBitSet& bits)
+    {
+        for (G4_Declare* dcl : dcls)
+        {
+            G4_RegVar* var = dcl->getRegVar();
+            if (!var->isRegAllocPartaker() || var->getId() >= numVarId || vars[var->getId()] != var)
+            {
+                return false;
+            }
+            bits.set(var->getId(), true);
+        }
+        return true;
+    };
+
+    SparseBitSet gen(numVarId), kill(numVarId), def(numVarId);
+    if (!toBits(sets.gen, gen) || !toBits(sets.kill, kill) || !toBits(sets.def, def))
+    {
+        return false;
+    }
+
+    use_gen[id] = std::move(gen);
+    use_kill[id] = std::move(kill);
+    def_out[id] = std::move(def);
+    use_in[id] = use_gen[id];
+
+#ifdef _DEBUG
+    verifyRestoredGenKill(bb, sets.pseudoKills);
+#endif
+
+    // Pseudo kills were recorded walking the BB backward, with the kills of
+    // one instruction next to each other in insertion order. Replay them from
+    // the last one in a single forward walk.
+    auto next = sets.pseudoKills.rbegin(), end = sets.pseudoKills.rend();
+    for (auto it = bb->begin(), itEnd = bb->end(); it != itEnd && next != end; ++it)
+    {
+        auto group = next;
+        while (next != end && next->second == *it)
+        {
+            ++next;
+        }
+        for (auto kill = next; kill != group;)
+        {
+            --kill;
+            bb->insertBefore(it, fg.builder->createPseudoKill(kill->first, PseudoKillType::FromLiveness));
+        }
+    }
+    MUST_BE_TRUE(next == end, "pseudo kill position not found");
+    return true;
+}
+
+//
+// Rescan a BB whose sets were restored from the snapshot and check that
+// they, and the pseudo kill positions, match; it must run before the
+// pseudo kills are replayed. Only called in debug builds.
+//
+void LivenessAnalysis::verifyRestoredGenKill(G4_BB* bb,
+    const std::vector<std::pair<G4_Declare*, G4_INST*>>& pseudoKills) const
+{
+    unsigned id = bb->getId();
+    SparseBitSet def(numVarId), in(numVarId), gen(numVarId), kill(numVarId);
+    std::vector<std::pair<G4_Declare*, G4_INST*>> kills;
+    computeGenKillandPseudoKill(bb, def, in, gen, kill, &kills, false);
+
+    MUST_BE_TRUE(!(gen != use_gen[id]) && !(kill != use_kill[id]) && !(def != def_out[id]),
+        "restored gen/kill sets differ from a rescan of the BB");
+    MUST_BE_TRUE(kills == pseudoKills, "restored pseudo kills differ from a rescan of the BB");
+}
+
+void LivenessAnalysis::saveGenKill(G4_BB* bb, uint64_t signature,
+    const std::vector<std::pair<G4_Declare*, G4_INST*>>& pseudoKills, LivenessSnapshot& snapshot) const
+{
+    unsigned id = bb->getId();
+    LivenessSnapshot::BBSets& sets = snapshot.bbSets[id];
+
+    auto toDcls = [this](const SparseBitSet& bits, std::vector<G4_Declare*>& dcls)
+    {
+        dcls.clear();
+        for (unsigned varId : bits)
+        {
+            if (!vars[varId])
+            {
+                return false;
+            }
+            dcls.push_back(vars[varId]->getDeclare());
+        }
+        return true;
+    };
+
+    sets.valid = toDcls(use_gen[id], sets.gen) && toDcls(use_kill[id], sets.kill) &&
+        toDcls(def_out[id], sets.def);
+    sets.signature = signature;
+    sets.pseudoKills = pseudoKills;
+}
+
+//
+// Run solveSCC on every SCC after the SCCs it depends on, i.e. its successors
+// for backward and its predecessors for forward problems. solveSCC may only
+// write the sets of the SCC's own BBs. With -numLivenessThreads, SCCs whose
+// dependences are solved run concurrently on worker threads.
+//
+void LivenessAnalysis::solveSCCs(const SCCOrder& sccs, bool backward, const std::function<void(unsigned)>& solveSCC)
+{
+    unsigned numSCC = sccs.getNumSCC();
+    unsigned numThreads = fg.builder->getOptions()->getuInt32Option(vISA_NumLivenessThreads);
+    if (numThreads <= 1 || numSCC <= 1)
+    {
+        // SCCs are in reverse topological order
+        for (unsigned i = 0; i < numSCC; i++)
+        {
+            solveSCC(backward ? i : numSCC - 1 - i);
+        }
+        return;
+    }
+
+    // Number of unsolved dependences of each SCC and the SCCs waiting on it
+    std::vector<unsigned> numPending(numSCC, 0);
+    std::vector<std::vector<unsigned>> waiting(numSCC);
+    for (unsigned scc = 0; scc < numSCC; scc++)
+    {
+        for (auto I = sccs.body_begin(scc), E = sccs.body_end(scc); I != E; ++I)
+        {
+            for (G4_BB* neighbor : backward ? (*I)->Succs : (*I)->Preds)
+            {
+                unsigned dep = sccs.getSCC(neighbor);
+                if (dep != scc && dep != SCCOrder::UNREACHABLE)
+                {
+                    numPending[scc]++;
+                    waiting[dep].push_back(scc);
+                }
+            }
+        }
+    }
+
+    std::vector<unsigned> ready;
+    for (unsigned scc = 0; scc < numSCC; scc++)
+    {
+        if (numPending[scc] == 0)
+        {
+            ready.push_back(scc);
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned numSolved = 0;
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            cv.wait(lock, [&]() { return !ready.empty() || numSolved == numSCC; });
+            if (ready.empty())
+            {
+                return;
+            }
+            unsigned scc = ready.back();
+            ready.pop_back();
+
+            lock.unlock();
+            solveSCC(scc);
+            lock.lock();
+
+            numSolved++;
+            for (unsigned next : waiting[scc])
+            {
+                if (--numPending[next] == 0)
+                {
+                    ready.push_back(next);
+                }
+            }
+            cv.notify_all();
+        }
+    };
+
+    numThreads = std::min(numThreads, numSCC);
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (unsigned t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+}
+
 //
 // use_out = use_in(s1) + use_in(s2) + ... where s1 s2 ... are the successors of bb
 // use_in  = use_gen + (use_out - use_kill)
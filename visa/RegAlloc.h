@@ -9,6 +9,7 @@ SPDX-License-Identifier: MIT
 #ifndef _REGALLOC_H_
 #define _REGALLOC_H_
 #include "PhyRegUsage.h"
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -449,6 +450,32 @@ struct VarRangeListPackage
     VAR_RANGE_LIST list;
 };
 
+class SCCOrder;
+
+// Per-BB gen, kill and def sets of the previous GRF RA iteration. Sets are
+// recorded by declare since variable ids are reassigned in every iteration,
+// along with the pseudo kills liveness inserted into the BB (each before
+// the given instruction). With -incrementalLiveness, BBs whose instructions
+// and referenced variables are unchanged reuse them instead of rescanning.
+struct LivenessSnapshot
+{
+    struct BBSets
+    {
+        bool valid = false;
+        uint64_t signature = 0;
+        std::vector<G4_Declare*> gen;
+        std::vector<G4_Declare*> kill;
+        std::vector<G4_Declare*> def;
+        std::vector<std::pair<G4_Declare*, G4_INST*>> pseudoKills;
+    };
+
+    unsigned char selectedRF = 0;
+    // Indexed by BB id
+    std::vector<BBSets> bbSets;
+    // Liveness candidates of the snapshot, indexed by declare id
+    std::vector<bool> candidates;
+};
+
 class LivenessAnalysis
 {
     unsigned numVarId = 0;         // the var count
@@ -469,10 +496,21 @@ class LivenessAnalysis
         SparseBitSet& def_out,
         SparseBitSet& use_in,
         SparseBitSet& use_gen,
-        SparseBitSet& use_kill) const;
+        SparseBitSet& use_kill,
+        std::vector<std::pair<G4_Declare*, G4_INST*>>* pseudoKillsInserted = nullptr,
+        bool insertPseudoKills = true) const;
+
+    uint64_t computeGenKillSignature(G4_BB* bb) const;
+    void prepareSnapshot(LivenessSnapshot& snapshot) const;
+    bool restoreGenKill(G4_BB* bb, uint64_t signature, const LivenessSnapshot& snapshot);
+    void verifyRestoredGenKill(G4_BB* bb,
+        const std::vector<std::pair<G4_Declare*, G4_INST*>>& pseudoKills) const;
+    void saveGenKill(G4_BB* bb, uint64_t signature,
+        const std::vector<std::pair<G4_Declare*, G4_INST*>>& pseudoKills, LivenessSnapshot& snapshot) const;
 
     bool contextFreeUseAnalyze(G4_BB* bb, bool isChanged);
     bool contextFreeDefAnalyze(G4_BB* bb, bool isChanged);
+    void solveSCCs(const SCCOrder& sccs, bool backward, const std::function<void(unsigned)>& solveSCC);
 
     bool livenessCandidate(const G4_Declare* decl, bool verifyRA) const;
 
@@ -509,7 +547,7 @@ public:
     bool setVarIDs(bool verifyRA, bool areAllPhyRegAssigned);
     LivenessAnalysis(GlobalRA& gra, unsigned char kind, bool verifyRA = false, bool forceRun = false);
     ~LivenessAnalysis();
-    void computeLiveness();
+    void computeLiveness(LivenessSnapshot* snapshot = nullptr);
     bool isLiveAtEntry(const G4_BB* bb, unsigned var_id) const;
     bool isUseThrough(const G4_BB* bb, unsigned var_id) const;
     bool isDefThrough(const G4_BB* bb, unsigned var_id) const;
@@ -10,72 +10,129 @@ SPDX-License-Identifier: MIT
 
 namespace vISA
 {
-    void Rematerialization::populateRefs()
+    void Rematerialization::collectBBRefs(G4_BB* bb, unsigned int& id, std::vector<RematCache::DclRefs>& bbRefs)
     {
-        unsigned int id = 0;
-        for (auto bb : kernel.fg)
+        // Index of each declare's entry in bbRefs
+        std::unordered_map<G4_Declare*, unsigned int> dclIdx;
+        auto getDclRefs = [&](G4_Declare* topdcl) -> RematCache::DclRefs&
         {
-            // Skip empty blocks.
-            if (bb->empty())
-                continue;
-
-            for (auto inst : *bb)
+            auto it = dclIdx.find(topdcl);
+            if (it == dclIdx.end())
             {
-                inst->setLexicalId(id++);
+                it = dclIdx.insert(std::make_pair(topdcl, (unsigned int)bbRefs.size())).first;
+                bbRefs.emplace_back();
+                bbRefs.back().dcl = topdcl;
+            }
+            return bbRefs[it->second];
+        };
 
-                if (inst->isPseudoKill())
-                    continue;
+        unsigned int bbStartId = id;
+        for (auto inst : *bb)
+        {
+            inst->setLexicalId(id++);
 
-                auto dst = inst->getDst();
+            if (inst->isPseudoKill())
+                continue;
 
-                if (dst && !dst->isNullReg())
-                {
-                    auto topdcl = dst->getTopDcl();
+            auto dst = inst->getDst();
 
-                    if (topdcl)
-                    {
-                        operations[topdcl].def.push_back(std::make_pair(inst, bb));
-                    }
+            if (dst && !dst->isNullReg())
+            {
+                auto topdcl = dst->getTopDcl();
+
+                if (topdcl)
+                {
+                    getDclRefs(topdcl).def.push_back(inst);
                 }
+            }
 
-                for (unsigned int i = 0; i < G4_MAX_SRCS; i++)
+            for (unsigned int i = 0; i < G4_MAX_SRCS; i++)
+            {
+                auto srcOpnd = inst->getSrc(i);
+                if (srcOpnd &&
+                    srcOpnd->isSrcRegRegion())
                 {
-                    auto srcOpnd = inst->getSrc(i);
-                    if (srcOpnd &&
-                        srcOpnd->isSrcRegRegion())
+                    auto topdcl = srcOpnd->asSrcRegRegion()->getTopDcl();
+                    unsigned int startRow = srcOpnd->getLeftBound() / kernel.numEltPerGRF<Type_UB>();
+                    unsigned int endRow = srcOpnd->getRightBound() / kernel.numEltPerGRF<Type_UB>();
+                    if (topdcl)
                     {
-                        auto topdcl = srcOpnd->asSrcRegRegion()->getTopDcl();
-                        unsigned int startRow = srcOpnd->getLeftBound() / kernel.numEltPerGRF<Type_UB>();
-                        unsigned int endRow = srcOpnd->getRightBound() / kernel.numEltPerGRF<Type_UB>();
-                        if (topdcl)
+                        auto& refs = getDclRefs(topdcl);
+                        refs.numUses++;
+                        for (unsigned int k = startRow; k <= endRow; k++)
                         {
-                            auto dclIt = operations.find(topdcl);
-                            if (dclIt == operations.end())
-                            {
-                                References r;
-                                r.numUses = 1;
-                                for (unsigned int k = startRow; k <= endRow; k++)
-                                {
-                                    r.rowsUsed.insert(k);
-                                }
-                                //r.uses.push_back(std::make_pair(inst, bb));
-                                r.lastUseLexId = inst->getLexicalId();
-                                operations.insert(std::make_pair(topdcl, r));
-                            }
-                            else
-                            {
-                                (*dclIt).second.numUses++;
-                                for (unsigned int k = startRow; k <= endRow; k++)
-                                {
-                                    (*dclIt).second.rowsUsed.insert(k);
-                                }
-                                (*dclIt).second.lastUseLexId = inst->getLexicalId();
-                                //(*dclIt).second.uses.push_back(std::make_pair(inst, bb));
-                            }
+                            refs.rowsUsed.push_back(k);
                         }
+                        refs.lastUseOffset = inst->getLexicalId() - bbStartId;
                     }
                 }
             }
+        }
+    }
+
+    void Rematerialization::mergeBBRefs(G4_BB* bb, unsigned int bbStartId, const std::vector<RematCache::DclRefs>& bbRefs)
+    {
+        for (auto&& refs : bbRefs)
+        {
+            auto& r = operations[refs.dcl];
+            for (auto defInst : refs.def)
+            {
+                r.def.push_back(std::make_pair(defInst, bb));
+            }
+            r.numUses += refs.numUses;
+            r.rowsUsed.insert(refs.rowsUsed.begin(), refs.rowsUsed.end());
+            if (refs.lastUseOffset != RematCache::NO_USE)
+            {
+                r.lastUseLexId = bbStartId + refs.lastUseOffset;
+            }
+        }
+    }
+
+    void Rematerialization::populateRefs()
+    {
+        // With -rematEveryIter, references of BBs left unchanged since the
+        // previous remat run are taken from the cache.
+        RematCache* cache = gra.rematCache.get();
+        if (cache)
+        {
+            cache->bbSignature.resize(kernel.fg.getNumBB(), 0);
+            cache->bbRefs.resize(kernel.fg.getNumBB());
+        }
+
+        unsigned int id = 0;
+        unsigned int numRescanned = 0;
+        std::vector<RematCache::DclRefs> bbRefs;
+        for (auto bb : kernel.fg)
+        {
+            // Skip empty blocks.
+            if (bb->empty())
+                continue;
+
+            unsigned int bbStartId = id;
+            unsigned int bbId = bb->getId();
+            bool cacheable = cache && bbId < cache->bbRefs.size();
+            uint64_t signature = cacheable ? Interference::computeBBSignature(bb) : 0;
+            if (cacheable && cache->bbSignature[bbId] == signature)
+            {
+                for (auto inst : *bb)
+                {
+                    inst->setLexicalId(id++);
+                }
+                mergeBBRefs(bb, bbStartId, cache->bbRefs[bbId]);
+            }
+            else
+            {
+                bbRefs.clear();
+                collectBBRefs(bb, id, bbRefs);
+                mergeBBRefs(bb, bbStartId, bbRefs);
+                numRescanned++;
+
+                if (cacheable)
+                {
+                    cache->bbSignature[bbId] = signature;
+                    cache->bbRefs[bbId] = bbRefs;
+                }
+            }
 
             // Update lastUseLexId based on BB live-out set
             const SparseBitSet &UseOut = liveness.use_out[bb->getId()];
@@ -95,6 +152,12 @@ namespace vISA
             }
         }
 
+        if (cache && kernel.getOption(vISA_RATrace))
+        {
+            std::cout << "\t--remat: rescanned " << numRescanned << " of " << kernel.fg.size() <<
+                " BBs, " << cache->budget - cache->numQueries << " queries left\n";
+        }
+
         for (auto& ref : operations)
         {
             auto dcl = ref.first;
@@ -546,24 +609,30 @@ namespace vISA
         if (!uniqueDef)
             return false;
 
-        if (gra.isNoRemat(uniqueDef->first))
+        // Def was rejected by an earlier remat run for reasons below that
+        // do not change across RA iterations.
+        if (gra.rematCache &&
+            gra.rematCache->rejectedDefs.count(uniqueDef->first))
             return false;
 
+        if (gra.isNoRemat(uniqueDef->first))
+            return rejectDef(uniqueDef->first);
+
         // Def has a lot of uses so we will need lots of remat to make this profitable
         if (refs.numUses > MAX_USES_REMAT)
             return false;
 
         if (uniqueDef->first->getCondMod())
-            return false;
+            return rejectDef(uniqueDef->first);
 
         if (uniqueDef->first->getPredicate() &&
             !usesNoMaskWA(uniqueDef))
-            return false;
+            return rejectDef(uniqueDef->first);
 
         // It is illegal to rematerialize intrinsic.split instruction as it
         // is dependent on an earlier send.
         if (uniqueDef->first->isSplitIntrinsic())
-            return false;
+            return rejectDef(uniqueDef->first);
 
         ref = uniqueDef;
 
@@ -573,7 +642,7 @@ namespace vISA
         auto uniqueDefBB = uniqueDef->second;
 
         if (!isRematCandidateOp(uniqueDefInst))
-            return false;
+            return rejectDef(uniqueDefInst);
 
         unsigned int srcLexId = srcInst->getLexicalId();
         unsigned int origOpLexId = uniqueDefInst->getLexicalId();
@@ -1165,9 +1234,15 @@ namespace vISA
         populateRefs();
 
         auto firstProgInst = kernel.fg.getEntryBB()->getFirstInst();
+        RematCache* cache = gra.rematCache.get();
 
         for (auto bb : kernel.fg)
         {
+            if (cache && !cache->hasBudget())
+            {
+                break;
+            }
+
             if (kernel.getInt32KernelAttr(Attributes::ATTR_Target) == VISATarget::VISA_3D)
             {
                 // For Cm, assume cr0 def is live across BBs
@@ -1231,6 +1306,15 @@ namespace vISA
                         const Reference* uniqueDef = nullptr;
                         G4_SrcRegRegion* rematSrc = nullptr;
 
+                        if (cache)
+                        {
+                            // Stop once the effort budget of all remat
+                            // runs on this kernel is used up.
+                            if (!cache->hasBudget())
+                                break;
+                            cache->numQueries++;
+                        }
+
                         bool canRemat = canRematerialize(src->asSrcRegRegion(), bb, uniqueDef, instIt);
                         if (canRemat)
                         {
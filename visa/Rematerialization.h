@@ -92,6 +92,14 @@ namespace vISA
         bool cr0DefBB = false;
 
         void populateRefs();
+        void collectBBRefs(G4_BB* bb, unsigned int& id, std::vector<RematCache::DclRefs>& bbRefs);
+        void mergeBBRefs(G4_BB* bb, unsigned int bbStartId, const std::vector<RematCache::DclRefs>& bbRefs);
+        bool rejectDef(G4_INST* defInst)
+        {
+            if (gra.rematCache)
+                gra.rematCache->rejectedDefs.insert(defInst);
+            return false;
+        }
         void populateSamplerHeaderMap();
         void deLVNSamplers(G4_BB*);
         bool usesNoMaskWA(const Reference* uniqueDef);
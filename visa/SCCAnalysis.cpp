@@ -125,3 +125,82 @@ void SCCAnalysis::dump(std::ostream &os) const
         SCC.dump(os);
     }
 }
+
+SCCOrder::SCCOrder(const FlowGraph& fg)
+{
+    const unsigned numBB = fg.getNumBB();
+    sccOf.assign(numBB, UNREACHABLE);
+    sccStart.push_back(0);
+    if (fg.empty())
+    {
+        return;
+    }
+
+    // Tarjan's algorithm with an explicit DFS stack.
+    const unsigned UNVISITED = UINT_MAX;
+    std::vector<unsigned> index(numBB, UNVISITED);
+    std::vector<unsigned> lowLink(numBB, 0);
+    std::vector<unsigned> postNum(numBB, 0);
+    std::vector<bool> onStack(numBB, false);
+    std::vector<G4_BB*> sccStack;
+    std::vector<std::pair<G4_BB*, BB_LIST_ITER>> dfsStack;
+    unsigned curIndex = 0, curPost = 0;
+
+    auto visit = [&](G4_BB* bb)
+    {
+        unsigned id = bb->getId();
+        index[id] = lowLink[id] = curIndex++;
+        onStack[id] = true;
+        sccStack.push_back(bb);
+        dfsStack.emplace_back(bb, bb->Succs.begin());
+    };
+
+    // entry BB
+    visit(*fg.cbegin());
+    while (!dfsStack.empty())
+    {
+        G4_BB* bb = dfsStack.back().first;
+        unsigned id = bb->getId();
+        if (dfsStack.back().second != bb->Succs.end())
+        {
+            G4_BB* succ = *dfsStack.back().second++;
+            unsigned succId = succ->getId();
+            if (index[succId] == UNVISITED)
+            {
+                visit(succ);
+            }
+            else if (onStack[succId])
+            {
+                lowLink[id] = std::min(lowLink[id], index[succId]);
+            }
+            continue;
+        }
+
+        postNum[id] = curPost++;
+        dfsStack.pop_back();
+        if (!dfsStack.empty())
+        {
+            unsigned parentId = dfsStack.back().first->getId();
+            lowLink[parentId] = std::min(lowLink[parentId], lowLink[id]);
+        }
+
+        if (lowLink[id] == index[id])
+        {
+            // bb is the root of an SCC made of it and everything above it
+            // on the SCC stack
+            unsigned sccId = getNumSCC();
+            auto first = std::find(sccStack.rbegin(), sccStack.rend(), bb).base() - 1;
+            for (auto it = first; it != sccStack.end(); ++it)
+            {
+                onStack[(*it)->getId()] = false;
+                sccOf[(*it)->getId()] = sccId;
+            }
+            size_t start = bbs.size();
+            bbs.insert(bbs.end(), first, sccStack.end());
+            sccStack.erase(first, sccStack.end());
+            std::sort(bbs.begin() + start, bbs.end(),
+                [&postNum](G4_BB* bb1, G4_BB* bb2) { return postNum[bb1->getId()] > postNum[bb2->getId()]; });
+            sccStart.push_back((unsigned)bbs.size());
+        }
+    }
+}
@@ -79,5 +79,32 @@ public:
 
     void dump(std::ostream &os = std::cerr) const;
 }; // class SCCAnalysis
+
+//
+// SCCs of the BBs reachable from the entry BB over all CFG edges, including
+// call and return edges (unlike SCCAnalysis, which looks through calls).
+// SCCs are in reverse topological order, i.e. an SCC comes after every SCC
+// it has edges into, and the BBs of each SCC are in reverse post order.
+// The DFS is iterative, so CFGs with thousands of BBs are fine.
+//
+class SCCOrder
+{
+    // BBs of all SCCs back to back, SCC i is [sccStart[i], sccStart[i+1])
+    std::vector<G4_BB*> bbs;
+    std::vector<unsigned> sccStart;
+    // indexed by BB id
+    std::vector<unsigned> sccOf;
+
+public:
+    static const unsigned UNREACHABLE = UINT_MAX;
+
+    SCCOrder(const FlowGraph& fg);
+
+    unsigned getNumSCC() const { return (unsigned)sccStart.size() - 1; }
+    std::vector<G4_BB*>::const_iterator body_begin(unsigned scc) const { return bbs.begin() + sccStart[scc]; }
+    std::vector<G4_BB*>::const_iterator body_end(unsigned scc) const { return bbs.begin() + sccStart[scc + 1]; }
+    // UNREACHABLE if bb is not reachable from the entry BB
+    unsigned getSCC(const G4_BB* bb) const { return sccOf[bb->getId()]; }
+}; // class SCCOrder
 }
 #endif // SCC_ANALYSIS
@@ -274,13 +274,8 @@ bool CoalesceSpillFills::fillHeuristic(std::list<INST_LIST_ITER>& coalesceableFi
     std::list<INST_LIST_ITER>& instList, const std::list<INST_LIST_ITER>& origInstList,
     unsigned int& min, unsigned int& max)
 {
-#if 0
     std::bitset<8> bits(0);
-    MUST_BE_TRUE(cMaxFillPayloadSize == 8, "Handle other max fill payload size");
-#else
-    std::bitset<4> bits(0);
-    MUST_BE_TRUE(cMaxFillPayloadSize == 4, "Handle other max fill payload size");
-#endif
+    MUST_BE_TRUE(maxFillPayloadSize == 4 || maxFillPayloadSize == 8, "Handle other max fill payload size");
 
     if (coalesceableFills.size() <= 1)
     {
@@ -403,6 +398,24 @@ bool CoalesceSpillFills::fillHeuristic(std::list<INST_LIST_ITER>& coalesceableFi
             return false;
         }
     }
+    else if (maxFillPayloadSize == 8 && max - min <= 7)
+    {
+        // Will emit an 8GRF read, only allowed in bulk-spill mode. Dont read
+        // more than 2 unused rows, two narrower reads would be cheaper.
+        std::bitset<8> usedRows(0);
+        for (auto f : coalesceableFills)
+        {
+            unsigned int scratchOffset, scratchSize;
+            getScratchMsgInfo(*f, scratchOffset, scratchSize);
+            for (auto i = scratchOffset; i < (scratchOffset + scratchSize); i++)
+                usedRows.set(i - min);
+        }
+
+        if (usedRows.count() < 6)
+        {
+            return false;
+        }
+    }
 
     return true;
 }
@@ -489,8 +502,8 @@ void CoalesceSpillFills::sendsInRange(std::list<INST_LIST_ITER>& instList,
 
             // Check whether min/max can be extended
             if (scratchOffset <= min &&
-                (min - scratchOffset) <= (cMaxFillPayloadSize - 1) &&
-                (max - scratchOffset) <= (cMaxFillPayloadSize - 1) &&
+                (min - scratchOffset) <= (maxFillPayloadSize - 1) &&
+                (max - scratchOffset) <= (maxFillPayloadSize - 1) &&
                 notOOB(scratchOffset, max))
             {
                 // This instruction can be coalesced
@@ -504,8 +517,8 @@ void CoalesceSpillFills::sendsInRange(std::list<INST_LIST_ITER>& instList,
                 iter = instList.erase(iter);
             }
             else if (scratchOffset >= max &&
-                (lastScratchOffset - min) <= (cMaxFillPayloadSize - 1) &&
-                (lastScratchOffset - max) <= (cMaxFillPayloadSize - 1) &&
+                (lastScratchOffset - min) <= (maxFillPayloadSize - 1) &&
+                (lastScratchOffset - max) <= (maxFillPayloadSize - 1) &&
                 notOOB(min, scratchOffset))
             {
                 max = lastScratchOffset;
@@ -668,7 +681,7 @@ void CoalesceSpillFills::keepConsecutiveSpills(std::list<INST_LIST_ITER>& instLi
     while (allowed.size() > 1)
     {
         unsigned int slots = maxOffset - minOffset + 1;
-        if (slots == 2 || slots == 4)
+        if (slots == 2 || slots == 4 || (slots == 8 && maxPayloadSize == 8))
         {
             // Insert coalescable spills in order of appearance
             for (auto origInst : origInstList)
@@ -738,7 +751,7 @@ INST_LIST_ITER CoalesceSpillFills::analyzeSpillCoalescing(std::list<INST_LIST_IT
     unsigned int min, max;
     G4_InstOption mask;
     bool useNoMask;
-    keepConsecutiveSpills(instList, coalesceableSpills, cMaxSpillPayloadSize, min, max, useNoMask, mask);
+    keepConsecutiveSpills(instList, coalesceableSpills, maxSpillPayloadSize, min, max, useNoMask, mask);
 
 #if 0
     printf("Start -- \n");
@@ -808,7 +821,7 @@ INST_LIST_ITER CoalesceSpillFills::analyzeFillCoalescing(std::list<INST_LIST_ITE
     std::list<INST_LIST_ITER> coalesceableFills;
     auto origInstList = instList;
     unsigned int min, max;
-    sendsInRange(instList, coalesceableFills, cMaxFillPayloadSize, min, max);
+    sendsInRange(instList, coalesceableFills, maxFillPayloadSize, min, max);
 
     bool heuristic = fillHeuristic(coalesceableFills, instList, origInstList, min, max);
     if (!heuristic)
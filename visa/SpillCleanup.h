@@ -12,6 +12,7 @@ SPDX-License-Identifier: MIT
 #include "G4_IR.hpp"
 #include "FlowGraph.h"
 #include "RPE.h"
+#include "GraphColor.h"
 
 namespace vISA
 {
@@ -37,6 +38,10 @@ namespace vISA
         const unsigned int cSpillWindowThreshold128GRF = 120;
         const unsigned int cHighRegPressureForCleanup = 100;
 
+        // cMax*PayloadSize, or the widest scratch block message in bulk-spill mode.
+        unsigned int maxFillPayloadSize = 0;
+        unsigned int maxSpillPayloadSize = 0;
+
         unsigned int fillWindowSizeThreshold = 0;
         unsigned int spillWindowSizeThreshold = 0;
         unsigned int highRegPressureForCleanup = 0;
@@ -96,6 +101,14 @@ namespace vISA
             fillWindowSizeThreshold = scale(cFillWindowThreshold128GRF);
             spillWindowSizeThreshold = scale(cSpillWindowThreshold128GRF);
             highRegPressureForCleanup = scale(cHighRegPressureForCleanup);
+
+            maxFillPayloadSize = cMaxFillPayloadSize;
+            maxSpillPayloadSize = cMaxSpillPayloadSize;
+            if (k.getOption(vISA_BulkSpill))
+            {
+                maxFillPayloadSize = std::max(maxFillPayloadSize, GlobalRA::getMaxScratchBlockGRFs(*k.fg.builder));
+                maxSpillPayloadSize = std::max(maxSpillPayloadSize, GlobalRA::getMaxScratchBlockGRFs(*k.fg.builder));
+            }
         }
 
         void run();
@@ -545,6 +545,133 @@ unsigned SpillManagerGRF::calculateSpillDispForLS(G4_RegVar* regVar) const
     return regVarLocDisp;
 }
 
+// Bulk-spill mode: assign the spill slots of this iteration before any spill
+// code is inserted. Spilled ranges referenced within a few instructions of
+// each other are grouped, up to the payload of one scratch block message, and
+// each group is placed in consecutive slots so that CoalesceSpillFills can
+// merge their fills and spills into wide messages.
+void SpillManagerGRF::assignBulkSpillDisps(FlowGraph& fg)
+{
+    const unsigned grfSize = builder_->numEltPerGRF<Type_UB>();
+    const unsigned maxGroupBytes = GlobalRA::getMaxScratchBlockGRFs(*builder_) * grfSize;
+    // Same as the window in which spill cleanup looks for coalescing candidates.
+    const unsigned windowSize = 10;
+
+    // Ranges whose disp would otherwise be computed by calculateSpillDisp().
+    std::unordered_set<G4_RegVar*> candidates;
+    for (const LiveRange* lr : *spilledLRs_)
+    {
+        G4_RegVar* regVar = lr->getVar();
+        if (regVar->getDisp() == UINT_MAX &&
+            regVar->getId() < varIdCount_ &&
+            !regVar->isRegVarTransient() &&
+            !regVar->isAliased() &&
+            getRFType(regVar) == G4_GRF &&
+            shouldSpillRegister(regVar) &&
+            gra.splitResults.find(regVar->getDeclare()->getRootDeclare()) == gra.splitResults.end())
+        {
+            candidates.insert(regVar);
+        }
+    }
+
+    std::vector<G4_RegVar*> group;
+    unsigned groupBytes = 0;
+    unsigned groupStart = 0;
+    unsigned instIdx = 0;
+    auto flushGroup = [&]()
+    {
+        if (!group.empty())
+        {
+            assignBulkSpillGroup(group);
+            group.clear();
+            groupBytes = 0;
+        }
+    };
+    auto addRef = [&](G4_Operand* opnd)
+    {
+        if (candidates.empty() || !opnd ||
+            !(opnd->isDstRegRegion() || opnd->isSrcRegRegion()) ||
+            !opnd->getBase()->isRegVar())
+        {
+            return;
+        }
+        G4_RegVar* regVar = getReprRegVar(opnd->getBase()->asRegVar());
+        if (candidates.erase(regVar) == 0)
+        {
+            return;
+        }
+        unsigned bytes = ROUND(getByteSize(regVar), grfSize);
+        if (groupBytes + bytes > maxGroupBytes)
+        {
+            flushGroup();
+        }
+        if (group.empty())
+        {
+            groupStart = instIdx;
+        }
+        group.push_back(regVar);
+        groupBytes += bytes;
+    };
+
+    for (G4_BB* bb : fg)
+    {
+        for (G4_INST* inst : *bb)
+        {
+            if (instIdx - groupStart >= windowSize)
+            {
+                flushGroup();
+            }
+            addRef(inst->getDst());
+            for (unsigned i = 0; i < G4_MAX_SRCS; i++)
+            {
+                addRef(inst->getSrc(i));
+            }
+            instIdx++;
+        }
+        // Fills and spills are not coalesced across BBs.
+        flushGroup();
+    }
+    flushGroup();
+}
+
+// Place the ranges of group back to back at the first offset where none of
+// them overlaps the slot of an interfering range.
+void SpillManagerGRF::assignBulkSpillGroup(const std::vector<G4_RegVar*>& group)
+{
+    const unsigned grfSize = builder_->numEltPerGRF<Type_UB>();
+
+    std::vector<std::pair<unsigned, unsigned>> blocked;
+    unsigned groupBytes = 0;
+    for (G4_RegVar* regVar : group)
+    {
+        groupBytes += ROUND(getByteSize(regVar), grfSize);
+        for (auto edge : spillIntf_->getSparseIntfForVar(regVar->getId()))
+        {
+            auto lrEdge = getRegVar(edge);
+            if (lrEdge->isRegVarTransient() || lrEdge->getDisp() == UINT_MAX)
+                continue;
+            unsigned start = lrEdge->getDisp();
+            blocked.emplace_back(start, ROUND(start + getByteSize(lrEdge), grfSize));
+        }
+    }
+    std::sort(blocked.begin(), blocked.end());
+
+    // As in calculateSpillDisp(), start searching from nextSpillOffset_.
+    unsigned disp = ROUND(nextSpillOffset_, grfSize);
+    for (auto& slot : blocked)
+    {
+        if (disp + groupBytes <= slot.first)
+            break;
+        disp = std::max(disp, slot.second);
+    }
+
+    for (G4_RegVar* regVar : group)
+    {
+        regVar->setDisp(disp);
+        disp += ROUND(getByteSize(regVar), grfSize);
+    }
+}
+
 // Get the spill/fill displacement of the segment containing the region.
 // A segment is the smallest dword or oword aligned portion of memory
 // containing the destination or source operand that can be read or saved.
@@ -4480,6 +4607,11 @@ bool SpillManagerGRF::insertSpillFillCode(
     updateRMWNeeded();
     FlowGraph& fg = kernel->fg;
 
+    if (doSpillSpaceCompression && builder_->getOption(vISA_BulkSpill))
+    {
+        assignBulkSpillDisps(fg);
+    }
+
     unsigned int id = 0;
     for (BB_LIST_ITER it = fg.begin(); it != fg.end(); it++)
     {
@@ -5078,6 +5210,58 @@ unsigned int GlobalRA::getHWordByteSize()
     return HWORD_BYTE_SIZE;
 }
 
+unsigned int GlobalRA::getMaxScratchBlockGRFs(const IR_Builder& builder)
+{
+    // HWord scratch block messages and transposed D32 LSC messages both move
+    // at most 8 HWords.
+    return hwordToGRFSize(8, builder);
+}
+
+GlobalRA::ScratchTraffic GlobalRA::getScratchTraffic() const
+{
+    ScratchTraffic traffic;
+    for (auto bb : kernel.fg)
+    {
+        for (auto inst : *bb)
+        {
+            unsigned numRows = 0;
+            bool isOffBP = false;
+            if (inst->isSpillIntrinsic())
+            {
+                numRows = inst->asSpillIntrinsic()->getNumRows();
+                isOffBP = inst->asSpillIntrinsic()->isOffBP();
+            }
+            else if (inst->isFillIntrinsic())
+            {
+                numRows = inst->asFillIntrinsic()->getNumRows();
+                isOffBP = inst->asFillIntrinsic()->isOffBP();
+            }
+            if (numRows == 0)
+                continue;
+
+            traffic.bytes += numRows * kernel.numEltPerGRF<Type_UB>();
+            // Same split as in expandSpillIntrinsic()/expandFillIntrinsic():
+            // stack call spill/fills off the frame pointer use oword block
+            // messages, the others hword scratch or LSC messages.
+            if (isOffBP && !useLscForNonStackCallSpillFill && !spillFillIntrinUsesLSC(inst))
+            {
+                for (unsigned numOwords = numRows * 2; numOwords > 0;)
+                {
+                    numOwords -= getPayloadSizeOword(numOwords);
+                    traffic.messages++;
+                }
+                continue;
+            }
+            while (numRows > 0)
+            {
+                numRows -= getPayloadSizeGRF(numRows);
+                traffic.messages++;
+            }
+        }
+    }
+    return traffic;
+}
+
 static G4_INST* createSpillFillAddr(
     IR_Builder& builder, G4_Declare* addr, G4_Declare* fp, int offset)
 {
@@ -5768,7 +5952,7 @@ void GlobalRA::expandFillStackcall(uint32_t numRows, uint32_t offset, short rowO
     }
 }
 
-bool GlobalRA::spillFillIntrinUsesLSC(G4_INST* spillFillIntrin)
+bool GlobalRA::spillFillIntrinUsesLSC(G4_INST* spillFillIntrin) const
 {
     G4_Declare* headerDcl = nullptr;
     if (!spillFillIntrin)
@@ -247,6 +247,10 @@ private:
 
     unsigned calculateSpillDispForLS(G4_RegVar* regVar) const;
 
+    void assignBulkSpillDisps(FlowGraph& fg);
+
+    void assignBulkSpillGroup(const std::vector<G4_RegVar*>& group);
+
     template <class REGION_TYPE>
     unsigned getMsgType(REGION_TYPE * region, G4_ExecSize   execSize);
 
@@ -9,11 +9,17 @@ SPDX-License-Identifier: MIT
 #include "Option.h"
 #include "Timer.h"
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <vector>
 #ifdef _WIN32
 #include "Windows.h"
+#else
+#include <unistd.h>
 #endif
 #include <cassert>
 
@@ -86,10 +92,203 @@ struct Timer {
     unsigned int hits;
 };
 
+namespace {
+struct TraceEvent {
+    std::string name;
+    const char* category;
+    char phase;      // 'B' or 'E'
+    unsigned tid;
+    int64_t ts;      // microseconds since tracing was enabled
+};
+
+// Events from all threads are appended under one lock; recording is
+// meant for diagnosing compiles, the lock is never taken otherwise.
+// Buffered events are written out whenever MAX_BUFFERED_EVENTS are pending,
+// so memory stays bounded and a crash loses at most that many events.
+class TraceEventRecorder {
+public:
+    static const size_t MAX_BUFFERED_EVENTS = 16 * 1024;
+
+    std::mutex lock;
+    std::vector<TraceEvent> events;
+    std::ofstream os;
+    unsigned pid = 0;
+    std::chrono::steady_clock::time_point start;
+
+    ~TraceEventRecorder() { finish(); }
+
+    bool open(const char* fileName);
+    void record(const char* name, const char* category, char phase);
+    // Both expect lock to be held.
+    void writeEvents();
+    void finish();
+};
+
+std::atomic<bool> traceEnabled(false);
+std::atomic<unsigned> numTraceThreads(0);
+_THREAD unsigned traceThreadId = 0;
+
+TraceEventRecorder& getTraceRecorder()
+{
+    static TraceEventRecorder recorder;
+    return recorder;
+}
+
+void TraceEventRecorder::record(const char* name, const char* category, char phase)
+{
+    if (traceThreadId == 0)
+    {
+        traceThreadId = ++numTraceThreads;
+    }
+    // timer names are indented for the text dumps
+    while (*name == '\t' || *name == ' ')
+    {
+        name++;
+    }
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> guard(lock);
+    int64_t ts = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+    events.push_back({name, category, phase, traceThreadId, ts});
+    if (events.size() >= MAX_BUFFERED_EVENTS)
+    {
+        writeEvents();
+    }
+}
+
+void writeJSONString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            os << '\\' << c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            os << ' ';
+        }
+        else
+        {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+// The file uses the JSON array format of trace events. Its closing bracket
+// is optional, so a trace cut short by a crash still loads.
+bool TraceEventRecorder::open(const char* fileName)
+{
+    os.open(fileName, std::ios_base::out);
+    if (!os)
+    {
+        return false;
+    }
+#ifdef _WIN32
+    pid = (unsigned)GetCurrentProcessId();
+#else
+    pid = (unsigned)getpid();
+#endif
+    os << "[\n";
+    os.flush();
+    start = std::chrono::steady_clock::now();
+    return true;
+}
+
+void TraceEventRecorder::writeEvents()
+{
+    if (!os.is_open())
+    {
+        return;
+    }
+    for (const TraceEvent& ev : events)
+    {
+        os << "{\"name\":";
+        writeJSONString(os, ev.name);
+        os << ",\"cat\":\"" << ev.category << "\",\"ph\":\"" << ev.phase <<
+            "\",\"ts\":" << ev.ts << ",\"pid\":" << pid << ",\"tid\":" << ev.tid << "},\n";
+    }
+    os.flush();
+    events.clear();
+}
+
+void TraceEventRecorder::finish()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!os.is_open())
+    {
+        return;
+    }
+    writeEvents();
+    // Closes the array without a trailing comma.
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid <<
+        ",\"args\":{\"name\":\"vISA\"}}\n]\n";
+    os.close();
+}
+
+bool isTracedTimer(TimerID ti)
+{
+    // These are started once per builder API call and would flood the trace.
+    return ti != TimerID::VISA_BUILDER_APPEND_INST &&
+        ti != TimerID::VISA_BUILDER_CREATE_VAR &&
+        ti != TimerID::VISA_BUILDER_CREATE_OPND &&
+        ti != TimerID::VISA_BUILDER_IR_CONSTRUCTION;
+}
+} // namespace
+
+extern "C" void enableTraceEvents(const char* fileName)
+{
+    TraceEventRecorder& recorder = getTraceRecorder();
+    std::lock_guard<std::mutex> guard(recorder.lock);
+    if (traceEnabled || fileName == nullptr || fileName[0] == '\0')
+    {
+        return;
+    }
+    if (recorder.open(fileName))
+    {
+        traceEnabled = true;
+    }
+}
+
+extern "C" bool traceEventsEnabled()
+{
+    return traceEnabled.load(std::memory_order_relaxed);
+}
+
+extern "C" void traceEventBegin(const char* name, const char* category)
+{
+    if (traceEventsEnabled())
+    {
+        getTraceRecorder().record(name, category, 'B');
+    }
+}
+
+extern "C" void traceEventEnd(const char* name, const char* category)
+{
+    if (traceEventsEnabled())
+    {
+        getTraceRecorder().record(name, category, 'E');
+    }
+}
+
 static _THREAD Timer timers[static_cast<int>(TimerID::NUM_TIMERS)];
 static _THREAD LARGE_INTEGER proc_freq;
 static _THREAD int numTimers = static_cast<int>(TimerID::NUM_TIMERS);
 
+struct PassStats {
+    const char* name;
+    int64_t ticks;
+    int64_t arenaBytes;
+    int64_t instDelta;
+    unsigned int hits;
+};
+
+// Enough for every entry of Optimizer::Passes.
+static const unsigned int MAX_PASS_STATS = 128;
+static _THREAD PassStats passStats[MAX_PASS_STATS];
+static _THREAD unsigned int numPassStats = 0;
+
 void initTimer() {
 
 #ifdef MEASURE_COMPILATION_TIME
@@ -106,6 +305,12 @@ void initTimer() {
     }
     QueryPerformanceFrequency(&proc_freq);
 #endif
+    numPassStats = 0;
+}
+
+extern "C" void initThreadTimers()
+{
+    initTimer();
 }
 
 void resetPerKernel()
@@ -128,6 +333,7 @@ void resetPerKernel()
         timers[i].started = false;
         timers[i].hits = 0;
     }
+    numPassStats = 0;
 }
 
 int createNewTimer(const char* name)
@@ -139,6 +345,10 @@ int createNewTimer(const char* name)
 void startTimer(TimerID timerId)
 {
     int timer = static_cast<int>(timerId);
+    if (traceEventsEnabled() && timer < static_cast<int>(TimerID::NUM_TIMERS) && isTracedTimer(timerId))
+    {
+        getTraceRecorder().record(timerNames[timer], "vISA", 'B');
+    }
 #ifdef MEASURE_COMPILATION_TIME
     if (timer < static_cast<int>(TimerID::NUM_TIMERS))
     {
@@ -171,6 +381,10 @@ void startTimer(TimerID timerId)
 void stopTimer(TimerID timerId)
 {
     int timer = static_cast<int>(timerId);
+    if (traceEventsEnabled() && timer < static_cast<int>(TimerID::NUM_TIMERS) && isTracedTimer(timerId))
+    {
+        getTraceRecorder().record(timerNames[timer], "vISA", 'E');
+    }
 #ifdef MEASURE_COMPILATION_TIME
     if (timer < static_cast<int>(TimerID::NUM_TIMERS))
     {
@@ -213,6 +427,114 @@ extern "C" unsigned int getTimerHits(unsigned int idx)
     return timers[idx].hits;
 }
 
+int64_t getTimerClock()
+{
+#ifdef MEASURE_COMPILATION_TIME
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart;
+#else
+    return 0;
+#endif
+}
+
+static PassStats* findPassStats(const char* name)
+{
+    // Names are compared by address; each pass has a single name literal.
+    unsigned int idx = 0;
+    while (idx < numPassStats && passStats[idx].name != name)
+    {
+        idx++;
+    }
+    if (idx == numPassStats)
+    {
+        if (numPassStats == MAX_PASS_STATS)
+        {
+            return nullptr;
+        }
+        passStats[idx] = {name, 0, 0, 0, 0};
+        numPassStats++;
+    }
+    return &passStats[idx];
+}
+
+void recordPassStats(const char* name, int64_t ticks, int64_t arenaBytes, int64_t instDelta)
+{
+    if (PassStats* stats = findPassStats(name))
+    {
+        stats->ticks += ticks;
+        stats->arenaBytes += arenaBytes;
+        stats->instDelta += instDelta;
+        stats->hits++;
+    }
+}
+
+TimerReadings saveTimers()
+{
+    TimerReadings readings;
+    readings.timers.reserve(static_cast<int>(TimerID::NUM_TIMERS));
+    for (int i = 0; i < static_cast<int>(TimerID::NUM_TIMERS); i++)
+    {
+        readings.timers.push_back({timers[i].time, timers[i].ticks, timers[i].hits});
+    }
+    for (unsigned int i = 0; i < numPassStats; i++)
+    {
+        const PassStats& stats = passStats[i];
+        readings.passes.push_back({stats.name, stats.ticks, stats.arenaBytes, stats.instDelta, stats.hits});
+    }
+    return readings;
+}
+
+void mergeTimers(const TimerReadings& readings)
+{
+    for (size_t i = 0; i < readings.timers.size(); i++)
+    {
+        timers[i].time += readings.timers[i].time;
+        timers[i].ticks += readings.timers[i].ticks;
+        timers[i].hits += readings.timers[i].hits;
+    }
+    for (const TimerReadings::PassEntry& pass : readings.passes)
+    {
+        if (PassStats* stats = findPassStats(pass.name))
+        {
+            stats->ticks += pass.ticks;
+            stats->arenaBytes += pass.arenaBytes;
+            stats->instDelta += pass.instDelta;
+            stats->hits += pass.hits;
+        }
+    }
+}
+
+extern "C" unsigned int getTotalPassStats()
+{
+    return numPassStats;
+}
+
+extern "C" const char* getPassStatName(unsigned int idx)
+{
+    return passStats[idx].name;
+}
+
+extern "C" int64_t getPassStatTicks(unsigned int idx)
+{
+    return passStats[idx].ticks;
+}
+
+extern "C" int64_t getPassStatArenaBytes(unsigned int idx)
+{
+    return passStats[idx].arenaBytes;
+}
+
+extern "C" int64_t getPassStatInstDelta(unsigned int idx)
+{
+    return passStats[idx].instDelta;
+}
+
+extern "C" unsigned int getPassStatHits(unsigned int idx)
+{
+    return passStats[idx].hits;
+}
+
 // static double getTimerUS(unsigned int idx)
 // {
 //     return (timers[idx].ticks * 1000000) / (double)proc_freq.QuadPart;
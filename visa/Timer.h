@@ -16,6 +16,9 @@ SPDX-License-Identifier: MIT
 
 #include "VISADefines.h"
 
+#include <cstdint>
+#include <vector>
+
 // Timer library for the compiler
 // To collect compile time information, do the following:
 //
@@ -44,8 +47,54 @@ void stopTimer(TimerID timer);
 void dumpAllTimers(const char *asmFileName, bool outputTime = false);
 void dumpEncoderStats(Options *opt, std::string &asmName);
 void resetPerKernel();
+// Current reading of the timer clock, in timer ticks.
+int64_t getTimerClock();
+// Accumulates the cost of one run of an optimizer pass for the current
+// kernel: ticks, bytes of new arenas and change in instruction count.
+// The host compiler reads them through getPassStat*. name must have static
+// storage duration.
+void recordPassStats(const char* name, int64_t ticks, int64_t arenaBytes, int64_t instDelta);
+
+// Timers and pass stats are thread local. Work finalized on a worker thread is
+// accounted to the reporting thread by taking the worker's readings with
+// saveTimers() and adding them to the reporting thread with mergeTimers().
+struct TimerReadings
+{
+    struct Entry
+    {
+        double time;
+        int64_t ticks;
+        unsigned int hits;
+    };
+    struct PassEntry
+    {
+        const char* name;
+        int64_t ticks;
+        int64_t arenaBytes;
+        int64_t instDelta;
+        unsigned int hits;
+    };
+    std::vector<Entry> timers;
+    std::vector<PassEntry> passes;
+};
+TimerReadings saveTimers();
+void mergeTimers(const TimerReadings& readings);
+// initTimer() for threads the host compiler runs VISABuilder::Compile on.
+extern "C" void initThreadTimers();
 // double getTimerUS(unsigned idx);
 
+// Timeline recording in Chrome trace event format (chrome://tracing,
+// ui.perfetto.dev). Once enableTraceEvents() is called, every timer
+// start/stop below (except the per-call VISA_BUILDER_* timers) and every
+// traceEventBegin/End from the host compiler is recorded with its thread
+// id. Events are appended to the file in batches and the file is completed
+// when the process exits. When tracing is not enabled each hook costs a
+// single flag check.
+extern "C" void enableTraceEvents(const char* fileName);
+extern "C" bool traceEventsEnabled();
+extern "C" void traceEventBegin(const char* name, const char* category);
+extern "C" void traceEventEnd(const char* name, const char* category);
+
 
 struct TimerScope {
     const TimerID timerId;
@@ -53,11 +102,9 @@ struct TimerScope {
     ~TimerScope() {stopTimer(timerId);}
 };
 
-#if defined(MEASURE_COMPILATION_TIME)
+// Scopes are kept without MEASURE_COMPILATION_TIME so that trace events
+// are available in release builds.
 #define  TIME_SCOPE(TIMER_ID) TimerScope __timerScope(TimerID::TIMER_ID);
-#else
-#define  TIME_SCOPE(TIMER_ID)
-#endif
 
 #undef DEF_TIMER
 
@@ -11,6 +11,7 @@ DEF_TIMER(TOTAL,                                                  "Total")
 DEF_TIMER(BUILDER,                                             "IR_Build")
 DEF_TIMER(CFG,                                                      "CFG")
 DEF_TIMER(OPTIMIZER,                                          "Optimizer")
+DEF_TIMER(LVN,                                                      "LVN")
 DEF_TIMER(HW_CONFORMITY,                                  "HW_Conformity")
 DEF_TIMER(MISC_OPTS,                                          "Misc_opts")
 DEF_TIMER(TOTAL_RA,                                            "Total_RA")
@@ -24,6 +25,7 @@ DEF_TIMER(COLORING,                                  "\t  Graph Coloring")
 DEF_TIMER(SPILL,                                              "\t  spill")
 DEF_TIMER(PRERA_SCHEDULING,                            "preRA_Scheduling")
 DEF_TIMER(SCHEDULING,                                        "Scheduling")
+DEF_TIMER(SWSB,                                                    "SWSB")
 DEF_TIMER(ENCODE_AND_EMIT,                                  "Encode+Emit")
 DEF_TIMER(ENCODE_COMPACTION,                                 "\tCompaction")
 DEF_TIMER(IGA_ENCODER,                                   "\tIGA_Encoding")
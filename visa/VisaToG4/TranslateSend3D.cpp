@@ -9,6 +9,8 @@ SPDX-License-Identifier: MIT
 #include "BuildIR.h"
 #include "../Timer.h"
 
+#include <atomic>
+
 using namespace vISA;
 
 static const unsigned MESSAGE_PRECISION_SUBTYPE_OFFSET  = 30;
@@ -1326,7 +1328,8 @@ static void setUniformSampler(G4_InstSend* sendInst, bool uniformSampler)
 Need to split sample_d and sample_dc in to two simd8 sends since HW doesn't support it.
 Also need to split any sample instruciton that has more then 5 parameters. Since there is a limit on msg length.
 */
-static unsigned TmpSmplDstID = 0;
+// Builders may translate concurrently.
+static std::atomic<unsigned> TmpSmplDstID(0);
 
 // TODO: use IR_Builder::getNameString....
 const char* getNameString(
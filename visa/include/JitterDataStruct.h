@@ -47,6 +47,10 @@ typedef struct _FINALIZER_INFO{
 
     // number of spill/fill, weighted by loop
     unsigned int numGRFSpillFill;
+    // static number of bytes moved by GRF spill/fill messages, and the same
+    // count before spill cleanup coalesced the messages
+    unsigned int numScratchBytesMoved = 0;
+    unsigned int numScratchBytesMovedBeforeCleanup = 0;
     // whether kernel recompilation should be avoided
     bool avoidRetry = false;
 
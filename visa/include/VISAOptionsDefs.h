@@ -130,6 +130,10 @@ DEF_VISA_OPTION(vISA_loadThreadPayloadStartReg, ET_INT32, "-setStartReg",UNUSED,
 DEF_VISA_OPTION(vISA_emitCrossThreadOffR0Reloc,  ET_BOOL, "-emitCrossThreadOffR0Reloc",    UNUSED, false)
 DEF_VISA_OPTION(vISA_CodePatch,   ET_INT32, "-codePatch",        UNUSED, 0)
 DEF_VISA_OPTION(vISA_Linker,      ET_INT32, "-linker",        UNUSED, 0)
+//   compile independent kernels of one builder on up to N worker threads (0/1: serial)
+DEF_VISA_OPTION(vISA_NumCompileThreads, ET_INT32, "-numCompileThreads", "USAGE: -numCompileThreads <num>\n", 0)
+//   KB of freed Mem_Manager arenas a compile keeps for reuse by its later Mem_Managers (0: no reuse)
+DEF_VISA_OPTION(vISA_ArenaPoolSizeKB, ET_INT32, "-arenaPoolSizeKB", "USAGE: -arenaPoolSizeKB <num>\n", 0)
 DEF_VISA_OPTION(vISA_lscEnableImmOffsFor,   ET_INT32, "-lscEnableImmOffsFor", UNUSED, 0x3001E)
 
 //=== RA options ===
@@ -153,9 +157,15 @@ DEF_VISA_OPTION(vISA_SpiltLLR,              ET_BOOL, "-nosplitllr",      UNUSED,
 DEF_VISA_OPTION(vISA_EnableGlobalScopeAnalysis,   ET_BOOL,  "-enableGlobalScopeAnalysis", UNUSED, false)
 DEF_VISA_OPTION(vISA_LocalDeclareSplitInGlobalRA, ET_BOOL, "-noLocalSplit",        UNUSED, true)
 DEF_VISA_OPTION(vISA_DisableSpillCoalescing, ET_BOOL, "-nospillcleanup", UNUSED, false)
+//   place spill slots of ranges referenced together contiguously and coalesce spills/fills up to 8 HWords
+DEF_VISA_OPTION(vISA_BulkSpill,             ET_BOOL, "-bulkSpill",       UNUSED, false)
 DEF_VISA_OPTION(vISA_GlobalSendVarSplit,    ET_BOOL, "-globalSendVarSplit", UNUSED, false)
 DEF_VISA_OPTION(vISA_NoRemat,               ET_BOOL, "-noremat",         UNUSED, false)
 DEF_VISA_OPTION(vISA_ForceRemat,            ET_BOOL, "-forceremat",      UNUSED, false)
+//   run remat on every failed GRF RA iteration, reusing references of unchanged BBs
+DEF_VISA_OPTION(vISA_RematEveryIter,        ET_BOOL, "-rematEveryIter",  UNUSED, false)
+//   with -rematEveryIter, remat operand queries allowed per kernel instruction over all RA iterations
+DEF_VISA_OPTION(vISA_RematEffort,           ET_INT32, "-rematEffort",           "USAGE: -rematEffort <num>\n",       4)
 DEF_VISA_OPTION(vISA_SpillMemOffset,        ET_INT32, "-spilloffset",           "USAGE: -spilloffset <offset>\n",     0)
 DEF_VISA_OPTION(vISA_ReservedGRFNum,        ET_INT32, "-reservedGRFNum",        "USAGE: -reservedGRFNum <regNum>\n",  0)
 DEF_VISA_OPTION(vISA_TotalGRFNum,           ET_INT32, "-TotalGRFNum",           "USAGE: -TotalGRFNum <regNum>\n",     128)
@@ -190,6 +200,9 @@ DEF_VISA_OPTION(vISA_preRA_ScheduleRPThreshold, ET_INT32, "-presched-rp",      "
 DEF_VISA_OPTION(vISA_ScheduleStartBBID, ET_INT32, "-sched-start",      "USAGE: -sched-start <BB ID>\n", 0)
 DEF_VISA_OPTION(vISA_ScheduleEndBBID, ET_INT32, "-sched-end",      "USAGE: -sched-end <BB ID>\n", 0)
 DEF_VISA_OPTION(vISA_DumpSchedule,          ET_BOOL, "-dumpSchedule",    UNUSED, false)
+//   JSON file overriding the scheduler latencies, see LocalScheduler/LatencyDefs.h
+DEF_VISA_OPTION(vISA_LatencyTableFile,     ET_CSTR, "-latencyTable",    "USAGE: -latencyTable <FILE>\n", NULL)
+DEF_VISA_OPTION(vISA_DumpLatencyTable,     ET_BOOL, "-dumpLatencyTable", UNUSED, false)
 DEF_VISA_OPTION(vISA_DumpDagDot,            ET_BOOL, "-dumpDagDot",      UNUSED, false)
 DEF_VISA_OPTION(vISA_EnableNoDD,            ET_BOOL, "-enable-noDD",     UNUSED, false)
 DEF_VISA_OPTION(vISA_DebugNoDD,             ET_BOOL, "-debug-noDD",      UNUSED, false)
@@ -213,6 +226,8 @@ DEF_VISA_OPTION(vISA_ScheduleFor2xSP, ET_BOOL, "-scheduleFor2xSP", UNUSED, false
 DEF_VISA_OPTION(vISA_SWSBBlockFor2xSP, ET_BOOL, "-SWSBBlockFor2xSP", UNUSED, false)
 DEF_VISA_OPTION(vISA_LocalSchedulingStartBB,   ET_INT32, "-scheduleStartBB", UNUSED, 0)
 DEF_VISA_OPTION(vISA_LocalSchedulingEndBB,     ET_INT32, "-scheduleEndBB", UNUSED, UINT_MAX)
+//   schedule independent basic blocks on up to N worker threads (0/1: serial)
+DEF_VISA_OPTION(vISA_NumSchedulerThreads,     ET_INT32, "-numSchedulerThreads", "USAGE: -numSchedulerThreads <num>\n", 0)
 DEF_VISA_OPTION(vISA_assumeL1Hit, ET_BOOL, "-assumeL1Hit", UNUSED, false)
 DEF_VISA_OPTION(vISA_writeCombine, ET_BOOL, "-writeCombine", UNUSED, true)
 DEF_VISA_OPTION(vISA_Q2FInIntegerPipe, ET_BOOL, "-Q2FInteger", UNUSED, false)
@@ -249,6 +264,10 @@ DEF_VISA_OPTION(vISA_SplitMov64,            ET_INT32,"-SplitMov64",  "USAGE: -Sp
 DEF_VISA_OPTION(vISA_UseOldSubRoutineAugIntf,    ET_BOOL, "-useOldSubRoutineAugIntf",     UNUSED, false)
 DEF_VISA_OPTION(vISA_FastCompileRA,    ET_BOOL, "-fastCompileRA",     UNUSED, false)
 DEF_VISA_OPTION(vISA_HybridRAWithSpill,    ET_BOOL, "-hybridRAWithSpill",     UNUSED, false)
+DEF_VISA_OPTION(vISA_IncrementalIntf,      ET_BOOL, "-incrementalIntf",       UNUSED, false)
+DEF_VISA_OPTION(vISA_IncrementalLiveness,  ET_BOOL, "-incrementalLiveness",   UNUSED, false)
+//   solve liveness of independent SCCs on up to N worker threads (0/1: serial)
+DEF_VISA_OPTION(vISA_NumLivenessThreads,   ET_INT32, "-numLivenessThreads", "USAGE: -numLivenessThreads <num>\n", 0)
 
 //=== binary emission options ===
 DEF_VISA_OPTION(vISA_Compaction,          ET_BOOL,  "-nocompaction",    UNUSED, true)
@@ -355,6 +374,7 @@ DEF_VISA_OPTION(vISA_ScratchAllocForStackInKB, ET_INT32, "-scratchAllocForStackI
 
 DEF_VISA_OPTION(vISA_dumpToCurrentDir,    ET_BOOL, "-dumpToCurrentDir",   UNUSED, false)
 DEF_VISA_OPTION(vISA_dumpTimer,           ET_BOOL, "-timestats",          UNUSED, false)
+DEF_VISA_OPTION(vISA_CountersFile,        ET_CSTR, "-countersFile",       "USAGE: -countersFile <file>\n", NULL)
 DEF_VISA_OPTION(vISA_EnableCompilerStats,   ET_BOOL, "-compilerStats",      UNUSED, false)
 
 DEF_VISA_OPTION(vISA_3DOption,            ET_BOOL, "-3d",                 UNUSED, false)
@@ -425,21 +425,6 @@ int main(int argc, const char *argv[])
             break;
     }
 
-
-#ifdef COLLECT_ALLOCATION_STATS
-#if 0
-    cout << "# allocation: " << numAllocations << endl;
-    cout << "total allocation size: " << (totalAllocSize / 1024) << " KB" << endl;
-    cout << "# mallocs: " << numMallocCalls << endl;
-    cout << "total malloc size: " << (totalMallocSize / 1024) << " KB" << endl;
-    cout << "# memory managers: " << numMemManagers << endl;
-    cout << "Max Arena list length: " << maxArenaLength << endl;
-#else
-    cout << numAllocations << "\t" << (totalAllocSize / 1024) << "\t" <<
-        numMallocCalls << "\t" << (totalMallocSize / 1024) << "\t" << numMemManagers <<
-        "\t" << maxArenaLength << endl;
-#endif
-#endif
     return err;
 }
 #endif